@@ -11,6 +11,39 @@
 #include <limits>
 #include <string>
 #include <fstream>
+#include <vector>
+#include <list>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <algorithm>
+#include <filesystem>
+#include <ctime>
+#include <chrono>
+#include <cctype>
+#include <thread>
+#include <atomic>
+#include <iomanip>
+#include <bitset>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <cstring>
+#include <cerrno>
+#include <csignal>
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/resource.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 
@@ -56,87 +89,598 @@ public:
     }
 };
 
+// Dictionary code space: bytes below 0x80 are literal ASCII, 0x80-0xEF are
+// one-byte codes, 0xF0-0xFE start two-byte codes (second byte 0x80-0xFF) and
+// 0xFF escapes one raw non-ASCII byte. No code ever produces a newline, so
+// compressed text stays line-safe in the data files.
+const int DICT_SHORT_CODES = 0xF0 - 0x80;
+const int DICT_LONG_CODES = (0xFF - 0xF0) * 0x80;
+const int DICT_MAX_ENTRIES = DICT_SHORT_CODES + DICT_LONG_CODES;
+const unsigned char DICT_ESCAPE = 0xFF;
+const string DICTIONARY_FILE = "complaint_dictionary.txt";
+
+// Word dictionary trained on complaint text. Entries are frequent words,
+// optionally with their trailing space, which suits short repetitive text
+// far better than a general-purpose compressor without shared context.
+class TextDictionary {
+private:
+    vector<string> entries;
+    unordered_map<string, int> codes;
+
+    static bool isWordChar(unsigned char c) {
+        return c < 0x80 && (isalnum(c) || c == '\'');
+    }
+
+    // Length of the word starting at pos, plus its trailing space if any
+    static size_t tokenLength(const string& text, size_t pos, size_t& wordLength) {
+        size_t end = pos;
+        while (end < text.size() && isWordChar(text[end])) end++;
+        wordLength = end - pos;
+        return (end < text.size() && text[end] == ' ') ? wordLength + 1 : wordLength;
+    }
+
+public:
+    void addEntry(const string& entry) {
+        codes[entry] = (int)entries.size();
+        entries.push_back(entry);
+    }
+
+    // Picks the words that save the most bytes across samples; the most
+    // frequent ones get the one-byte codes
+    void train(const vector<string>& samples) {
+        unordered_map<string, long> counts;
+        for (const string& text : samples) {
+            size_t pos = 0;
+            while (pos < text.size()) {
+                size_t wordLength;
+                size_t length = tokenLength(text, pos, wordLength);
+                if (wordLength == 0) {
+                    pos++;
+                    continue;
+                }
+                counts[text.substr(pos, length)]++;
+                pos += length;
+            }
+        }
+        vector<pair<long, string>> candidates; // (bytes saved with a long code, entry)
+        for (const auto& entry : counts) {
+            if (entry.second >= 2 && entry.first.size() >= 3) {
+                candidates.push_back({entry.second * (long)(entry.first.size() - 2), entry.first});
+            }
+        }
+        sort(candidates.rbegin(), candidates.rend());
+        if ((int)candidates.size() > DICT_MAX_ENTRIES) candidates.resize(DICT_MAX_ENTRIES);
+        stable_sort(candidates.begin(), candidates.end(),
+                    [&](const pair<long, string>& a, const pair<long, string>& b) {
+                        return counts[a.second] > counts[b.second];
+                    });
+        entries.clear();
+        codes.clear();
+        for (const auto& candidate : candidates) addEntry(candidate.second);
+    }
+
+    string encode(const string& text) const {
+        string out;
+        out.reserve(text.size());
+        size_t pos = 0;
+        while (pos < text.size()) {
+            unsigned char c = text[pos];
+            size_t wordLength;
+            size_t length = isWordChar(c) ? tokenLength(text, pos, wordLength) : 0;
+            if (length > 0) {
+                auto it = codes.find(text.substr(pos, length));
+                if (it == codes.end() && length > wordLength) {
+                    length = wordLength;
+                    it = codes.find(text.substr(pos, length));
+                }
+                if (it != codes.end()) {
+                    int code = it->second;
+                    if (code < DICT_SHORT_CODES) {
+                        out += (char)(0x80 + code);
+                    } else {
+                        code -= DICT_SHORT_CODES;
+                        out += (char)(0xF0 + code / 0x80);
+                        out += (char)(0x80 + code % 0x80);
+                    }
+                } else {
+                    out.append(text, pos, length);
+                }
+                pos += length;
+            } else {
+                if (c >= 0x80) out += (char)DICT_ESCAPE;
+                out += (char)c;
+                pos++;
+            }
+        }
+        return out;
+    }
+
+    string decode(const string& data) const {
+        string out;
+        out.reserve(data.size() * 2);
+        for (size_t pos = 0; pos < data.size(); pos++) {
+            unsigned char c = data[pos];
+            int code = -1;
+            if (c < 0x80) {
+                out += (char)c;
+            } else if (c == DICT_ESCAPE) {
+                if (++pos < data.size()) out += data[pos];
+            } else if (c < 0xF0) {
+                code = c - 0x80;
+            } else if (++pos < data.size()) {
+                code = DICT_SHORT_CODES + (c - 0xF0) * 0x80 + ((unsigned char)data[pos] - 0x80);
+            }
+            if (code >= 0 && code < (int)entries.size()) out += entries[code];
+        }
+        return out;
+    }
+
+    bool empty() const { return entries.empty(); }
+    const vector<string>& getEntries() const { return entries; }
+};
+
+// Trained dictionary generations; text keeps the generation that encoded it,
+// so retraining never invalidates existing records
+vector<TextDictionary> textDictionaries;
+
+// Decode counters for the display and search paths
+struct CompressionStats {
+    long decodes;
+    long long decodeNanos;
+};
+CompressionStats compressionStats = {0, 0};
+
+// Complaint text stored compressed with the newest dictionary when that is
+// smaller, and decompressed only when it is displayed or searched
+class CompressedText {
+private:
+    string data;
+    unsigned short generation; // 1-based dictionary generation, 0 when plain
+
+public:
+    CompressedText(const string& text = "") : generation(0) { assign(text); }
+
+    CompressedText& operator=(const string& text) {
+        assign(text);
+        return *this;
+    }
+
+    void assign(const string& text) {
+        data = text;
+        generation = 0;
+        if (textDictionaries.empty() || text.empty()) return;
+        string encoded = textDictionaries.back().encode(text);
+        if (encoded.size() < text.size()) {
+            data = encoded;
+            generation = (unsigned short)textDictionaries.size();
+        }
+    }
+
+    // Decodes without touching the latency counters
+    string plain() const {
+        if (generation == 0) return data;
+        if (generation > textDictionaries.size()) return "<missing compression dictionary>";
+        return textDictionaries[generation - 1].decode(data);
+    }
+
+    // Decodes for display or search, recording decode latency
+    string str() const {
+        if (generation == 0) return data;
+        auto start = chrono::steady_clock::now();
+        string text = plain();
+        compressionStats.decodes++;
+        compressionStats.decodeNanos +=
+            chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+        return text;
+    }
+
+    bool isCompressed() const { return generation != 0; }
+    size_t storedSize() const { return data.size(); }
+
+    // Data file field: "p" + plain text, or "z<generation>:" + compressed bytes
+    string serialize() const {
+        if (generation == 0) return "p" + data;
+        return "z" + to_string(generation) + ":" + data;
+    }
+
+    void deserialize(const string& field) {
+        size_t colon = field.find(':');
+        if (!field.empty() && field[0] == 'z' && colon != string::npos) {
+            data = field.substr(colon + 1);
+            generation = (unsigned short)atoi(field.c_str() + 1);
+        } else {
+            assign(field.empty() ? field : field.substr(1));
+        }
+    }
+};
+
+ostream& operator<<(ostream& out, const CompressedText& text) {
+    return out << text.str();
+}
+
 // Structure to represent a complaint
 struct Complaint {
     static int lastId; // Tracks the last used complaint ID
     int id;
-    string content;
+    CompressedText content;
     bool replied;
     bool urgent;
     Customer customer;
-    string replyDetails;
+    CompressedText replyDetails;
+    time_t createdAt; // 0 when unknown (records saved before timestamps)
+    time_t repliedAt; // Time of the first reply, 0 while unreplied
+    int order;           // Urgent queue priority order, 0 when not queued
+    string summarizedBy; // ID of the employee who added the summary, if any
 
     Complaint(const string& content, bool replied, bool urgent, const Customer& customer)
-        : id(++lastId), content(content), replied(replied), urgent(urgent), customer(customer) {}
+        : id(++lastId), content(content), replied(replied), urgent(urgent), customer(customer),
+          createdAt(time(nullptr)), repliedAt(0), order(0) {}
+
+    // Empty record used as a target when reading complaints back from disk
+    Complaint()
+        : id(0), replied(false), urgent(false), customer("", "", ""), createdAt(0), repliedAt(0), order(0) {}
 
     void addReply(const string& reply) {
         replyDetails = reply;
+        if (!replied) repliedAt = time(nullptr);
         replied = true;
     }
 };
 int Complaint::lastId = 0;
 
-// Linked list-based queue for storing complaints
+// Escapes a field for '|'-separated lines: backslash, newline, carriage
+// return and '|' become \\, \n, \r and \|
+string escapeField(const string& text) {
+    if (text.find_first_of("\\\n\r|") == string::npos) return text;
+    string escaped;
+    escaped.reserve(text.size());
+    for (char c : text) {
+        switch (c) {
+        case '\\': escaped += "\\\\"; break;
+        case '\n': escaped += "\\n"; break;
+        case '\r': escaped += "\\r"; break;
+        case '|': escaped += "\\|"; break;
+        default: escaped += c;
+        }
+    }
+    return escaped;
+}
+
+string unescapeField(const string& text) {
+    string plain;
+    plain.reserve(text.size());
+    for (size_t i = 0; i < text.size(); i++) {
+        char c = text[i];
+        if (c == '\\' && i + 1 < text.size()) {
+            c = text[++i];
+            c = c == 'n' ? '\n' : c == 'r' ? '\r' : c;
+        }
+        plain += c;
+    }
+    return plain;
+}
+
+// Splits a line of escaped fields on unescaped '|' and unescapes each field
+vector<string> splitEscapedFields(const string& line) {
+    vector<string> fields(1);
+    for (size_t i = 0; i < line.size(); i++) {
+        char c = line[i];
+        if (c == '|') {
+            fields.emplace_back();
+        } else if (c == '\\' && i + 1 < line.size()) {
+            c = line[++i];
+            fields.back() += c == 'n' ? '\n' : c == 'r' ? '\r' : c;
+        } else {
+            fields.back() += c;
+        }
+    }
+    return fields;
+}
+
+// Version of the record format written to data files. Version 1 files have
+// no header and 8-line records; version 2 adds creation and reply times;
+// version 3 tags content and reply fields as plain or compressed; version 4
+// adds the urgent order and the summarizing employee; version 5 escapes the
+// text fields so they can hold newlines.
+const int DATA_FORMAT_VERSION = 5;
+
+void writeDataFileHeader(ostream& out) {
+    out << "# complaint-data v" << DATA_FORMAT_VERSION << "\n";
+}
+
+// Consumes the header line if present and returns the file's format version
+int readDataFileHeader(istream& in) {
+    if (in.peek() != '#') return 1;
+    string header;
+    getline(in, header);
+    size_t pos = header.rfind('v');
+    return pos == string::npos ? 1 : atoi(header.c_str() + pos + 1);
+}
+
+// Writes a complaint record in the current data file format
+void writeComplaintRecord(ostream& out, const Complaint& complaint) {
+    out << complaint.id << "\n";
+    out << escapeField(complaint.content.serialize()) << "\n";
+    out << complaint.replied << "\n";
+    out << complaint.urgent << "\n";
+    out << escapeField(complaint.customer.getName()) << "\n";
+    out << escapeField(complaint.customer.getPhone()) << "\n";
+    out << escapeField(complaint.customer.getEmail()) << "\n";
+    out << escapeField(complaint.replyDetails.serialize()) << "\n";
+    out << (long long)complaint.createdAt << "\n";
+    out << (long long)complaint.repliedAt << "\n";
+    out << complaint.order << "\n";
+    out << escapeField(complaint.summarizedBy) << "\n";
+}
+
+// Reads one complaint record written in the given format version; returns
+// false at end of input
+bool readComplaintRecord(istream& in, Complaint& complaint, int version) {
+    string name, phone, email, content, replyDetails;
+    if (!(in >> complaint.id)) return false;
+    in.ignore();
+    getline(in, content);
+    in >> complaint.replied >> complaint.urgent;
+    in.ignore();
+    getline(in, name);
+    getline(in, phone);
+    getline(in, email);
+    getline(in, replyDetails);
+    if (version >= 5) {
+        content = unescapeField(content);
+        name = unescapeField(name);
+        phone = unescapeField(phone);
+        email = unescapeField(email);
+        replyDetails = unescapeField(replyDetails);
+    }
+    if (version >= 3) {
+        complaint.content.deserialize(content);
+        complaint.replyDetails.deserialize(replyDetails);
+    } else {
+        complaint.content = content;
+        complaint.replyDetails = replyDetails;
+    }
+    complaint.createdAt = 0;
+    complaint.repliedAt = 0;
+    if (version >= 2) {
+        long long createdAt, repliedAt;
+        in >> createdAt >> repliedAt;
+        in.ignore();
+        complaint.createdAt = (time_t)createdAt;
+        complaint.repliedAt = (time_t)repliedAt;
+    }
+    complaint.order = 0;
+    complaint.summarizedBy.clear();
+    if (version >= 4) {
+        in >> complaint.order;
+        in.ignore();
+        getline(in, complaint.summarizedBy);
+        if (version >= 5) complaint.summarizedBy = unescapeField(complaint.summarizedBy);
+    }
+    complaint.customer = Customer(name, phone, email);
+    return true;
+}
+
+// Every field of a complaint, in the order encodeComplaint writes them
+const size_t COMPLAINT_FIELD_COUNT = 12;
+
+// Full complaint state as one line of escaped fields, plain text throughout
+// so the reader needs no compression dictionary
+string encodeComplaint(const Complaint& complaint) {
+    string line = to_string(complaint.id);
+    for (const string& field : {to_string((long long)complaint.createdAt), to_string((long long)complaint.repliedAt),
+                                to_string(complaint.replied), to_string(complaint.urgent),
+                                to_string(complaint.order), complaint.summarizedBy,
+                                complaint.customer.getName(), complaint.customer.getPhone(),
+                                complaint.customer.getEmail(), complaint.content.str(),
+                                complaint.replyDetails.str()}) {
+        line += '|';
+        line += escapeField(field);
+    }
+    return line;
+}
+
+bool decodeComplaint(const string& line, Complaint& complaint) {
+    vector<string> fields = splitEscapedFields(line);
+    if (fields.size() != COMPLAINT_FIELD_COUNT) return false;
+    complaint.id = atoi(fields[0].c_str());
+    complaint.createdAt = (time_t)atoll(fields[1].c_str());
+    complaint.repliedAt = (time_t)atoll(fields[2].c_str());
+    complaint.replied = fields[3] == "1";
+    complaint.urgent = fields[4] == "1";
+    complaint.order = atoi(fields[5].c_str());
+    complaint.summarizedBy = fields[6];
+    complaint.customer = Customer(fields[7], fields[8], fields[9]);
+    complaint.content = fields[10];
+    complaint.replyDetails = fields[11];
+    return complaint.id > 0;
+}
+
+long long wallClockMicros() {
+    return chrono::duration_cast<chrono::microseconds>(chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// Ordered log of store changes for replication. While enabled, every change
+// made through the store operations is appended as one line
+// "<sequence> <wall clock us> <OP> <escaped fields>"; the server hands the
+// pending lines to its replicas after each batch of requests.
+class ChangeLog {
+private:
+    bool enabled;
+    long sequence;
+    string pending;
+
+public:
+    ChangeLog() : enabled(false), sequence(0) {}
+
+    void enable() { enabled = true; }
+    bool isEnabled() const { return enabled; }
+    long getSequence() const { return sequence; }
+
+    void record(const char* op, const string& fields) {
+        if (!enabled) return;
+        sequence++;
+        pending += to_string(sequence) + ' ' + to_string(wallClockMicros()) + ' ' + op + ' ' + fields + '\n';
+    }
+
+    // Returns the lines recorded since the last call
+    string take() {
+        string lines;
+        lines.swap(pending);
+        return lines;
+    }
+};
+
+ChangeLog changeLog;
+
+// Generic linked containers. Each one takes the element type and an
+// allocator, which is rebound to the container's node type. Elements can be
+// inserted by copy, by move or constructed in place with emplace, and every
+// container supports range-for iteration.
+
+// Forward iterator over nodes that expose data and next
+template <typename Node, typename T>
+class NodeIterator {
+private:
+    Node* node;
+
+public:
+    typedef forward_iterator_tag iterator_category;
+    typedef typename remove_const<T>::type value_type;
+    typedef ptrdiff_t difference_type;
+    typedef T* pointer;
+    typedef T& reference;
+
+    NodeIterator(Node* n = nullptr) : node(n) {}
+
+    T& operator*() const { return node->data; }
+    T* operator->() const { return &node->data; }
+
+    NodeIterator& operator++() {
+        node = node->next;
+        return *this;
+    }
+
+    NodeIterator operator++(int) {
+        NodeIterator old = *this;
+        node = node->next;
+        return old;
+    }
+
+    bool operator==(const NodeIterator& other) const { return node == other.node; }
+    bool operator!=(const NodeIterator& other) const { return node != other.node; }
+
+    Node* getNode() const { return node; }
+};
+
+// Allocates and constructs nodes through the container's allocator
+template <typename Node, typename Alloc>
+class NodeAllocator {
+protected:
+    typedef typename allocator_traits<Alloc>::template rebind_alloc<Node> Allocator;
+    typedef allocator_traits<Allocator> Traits;
+    Allocator allocator;
+
+    NodeAllocator(const Alloc& alloc) : allocator(alloc) {}
+
+    template <typename... Args>
+    Node* createNode(Args&&... args) {
+        Node* node = Traits::allocate(allocator, 1);
+        try {
+            Traits::construct(allocator, node, forward<Args>(args)...);
+        } catch (...) {
+            Traits::deallocate(allocator, node, 1);
+            throw;
+        }
+        return node;
+    }
+
+    void destroyNode(Node* node) {
+        Traits::destroy(allocator, node);
+        Traits::deallocate(allocator, node, 1);
+    }
+};
+
+// Doubly linked queue; the back links let an element be removed from the
+// middle without a predecessor search
+template <typename T, typename Alloc = allocator<T>>
 class LinkedQueue {
 public:
     struct Node {
-        Complaint data;
+        T data;
         Node* next;
-        Node(const Complaint& complaint) : data(complaint), next(nullptr) {}
+        Node* prev;
+        template <typename... Args>
+        explicit Node(Args&&... args) : data(forward<Args>(args)...), next(nullptr), prev(nullptr) {}
     };
+    typedef NodeIterator<Node, T> iterator;
+    typedef NodeIterator<const Node, const T> const_iterator;
 
 private:
+    struct Nodes : NodeAllocator<Node, Alloc> {
+        Nodes(const Alloc& alloc) : NodeAllocator<Node, Alloc>(alloc) {}
+        using NodeAllocator<Node, Alloc>::createNode;
+        using NodeAllocator<Node, Alloc>::destroyNode;
+    };
+    Nodes nodes;
     Node* front;
     Node* rear;
     int size;
 
+    T& linkBack(Node* newNode) {
+        if (isEmpty()) {
+            front = rear = newNode;
+        } else {
+            newNode->prev = rear;
+            rear->next = newNode;
+            rear = newNode;
+        }
+        size++;
+        return newNode->data;
+    }
+
 public:
-    LinkedQueue() : front(nullptr), rear(nullptr), size(0) {}
+    explicit LinkedQueue(const Alloc& alloc = Alloc()) : nodes(alloc), front(nullptr), rear(nullptr), size(0) {}
 
     ~LinkedQueue() {
         while (front != nullptr) {
             Node* temp = front;
             front = front->next;
-            delete temp;
+            nodes.destroyNode(temp);
         }
         rear = nullptr;
         size = 0;
     }
 
+    LinkedQueue(const LinkedQueue&) = delete;
+    LinkedQueue& operator=(const LinkedQueue&) = delete;
+
     bool isEmpty() const { return size == 0; }
 
-    void enqueue(const Complaint& value) {
-        Node* newNode = new Node(value);
-        if (isEmpty()) {
-            front = rear = newNode;
-        } else {
-            rear->next = newNode;
-            rear = newNode;
-        }
-        size++;
+    T& enqueue(const T& value) { return linkBack(nodes.createNode(value)); }
+    T& enqueue(T&& value) { return linkBack(nodes.createNode(move(value))); }
+
+    // Constructs the element in place at the back of the queue
+    template <typename... Args>
+    T& emplace(Args&&... args) {
+        return linkBack(nodes.createNode(forward<Args>(args)...));
     }
 
     void dequeue() {
-        if (isEmpty()) {
-            cout << "No complaints in queue.\n";
-            return;
-        }
+        if (isEmpty()) return;
         Node* temp = front;
         front = front->next;
-        delete temp;
+        nodes.destroyNode(temp);
         size--;
         if (front == nullptr) {
             rear = nullptr;
+        } else {
+            front->prev = nullptr;
         }
     }
 
-    Complaint getFront() const {
-        if (isEmpty()) {
-            cout << "Queue is empty.\n";
-            return Complaint("", false, false, Customer("", "", ""));
-        }
-        return front->data;
-    }
+    // Front element; the queue must not be empty
+    const T& getFront() const { return front->data; }
 
     int getSize() const { return size; }
 
@@ -146,640 +690,4691 @@ public:
     // Returns the rear node
     Node* getRearNode() const { return rear; }
 
-    // Sets the rear node
-    void setRear(Node* node) { rear = node; }
-
-    // Decrements the size
-    void decrementSize() { if (size > 0) size--; }
-
-    void display() const {
-        if (isEmpty()) {
-            cout << "No complaints to display.\n";
-            return;
+    // Unlinks and destroys a node anywhere in the queue
+    void remove(Node* node) {
+        if (node->prev == nullptr) {
+            front = node->next;
+        } else {
+            node->prev->next = node->next;
         }
-        Node* current = front;
-        cout << "Complaints in queue:\n";
-        while (current != nullptr) {
-            cout << "-----------------------------------------\n";
-            cout << "ID: " << current->data.id << "\n";
-            cout << "Content: " << current->data.content << "\n";
-            cout << "Customer Name: " << current->data.customer.getName() << "\n";
-            cout << "Customer Email: " << current->data.customer.getEmail() << "\n";
-            cout << "Replied: " << (current->data.replied ? "Yes" : "No") << "\n";
-            if (current->data.replied) {
-                cout << "Reply Details: " << current->data.replyDetails << "\n";
-            }
-            cout << "Urgent: " << (current->data.urgent ? "Yes" : "No") << "\n";
-            current = current->next;
+        if (node->next == nullptr) {
+            rear = node->prev;
+        } else {
+            node->next->prev = node->prev;
         }
-        cout << "-----------------------------------------\n";
+        nodes.destroyNode(node);
+        size--;
     }
+
+    iterator begin() { return iterator(front); }
+    iterator end() { return iterator(); }
+    const_iterator begin() const { return const_iterator(front); }
+    const_iterator end() const { return const_iterator(); }
 };
-LinkedQueue complaintQueue;
 
-// Stack for storing problem summaries
+// Stack; iteration runs from the top down
+template <typename T, typename Alloc = allocator<T>>
 class Stack {
 public:
     struct Node {
-        Complaint data;
+        T data;
         Node* next;
-        Node(const Complaint& complaint) : data(complaint), next(nullptr) {}
+        template <typename... Args>
+        explicit Node(Args&&... args) : data(forward<Args>(args)...), next(nullptr) {}
     };
+    typedef NodeIterator<Node, T> iterator;
+    typedef NodeIterator<const Node, const T> const_iterator;
 
 private:
+    struct Nodes : NodeAllocator<Node, Alloc> {
+        Nodes(const Alloc& alloc) : NodeAllocator<Node, Alloc>(alloc) {}
+        using NodeAllocator<Node, Alloc>::createNode;
+        using NodeAllocator<Node, Alloc>::destroyNode;
+    };
+    Nodes nodes;
     Node* top;
     int size;
 
+    T& linkTop(Node* newNode) {
+        newNode->next = top;
+        top = newNode;
+        size++;
+        return newNode->data;
+    }
+
 public:
-    Stack() : top(nullptr), size(0) {}
+    explicit Stack(const Alloc& alloc = Alloc()) : nodes(alloc), top(nullptr), size(0) {}
 
     ~Stack() {
         while (top != nullptr) {
             Node* temp = top;
             top = top->next;
-            delete temp;
+            nodes.destroyNode(temp);
         }
         size = 0;
     }
 
+    Stack(const Stack&) = delete;
+    Stack& operator=(const Stack&) = delete;
+
     bool isEmpty() const { return size == 0; }
 
-    void push(const Complaint& complaint) {
-        Node* newNode = new Node(complaint);
-        newNode->next = top;
-        top = newNode;
-        size++;
+    T& push(const T& value) { return linkTop(nodes.createNode(value)); }
+    T& push(T&& value) { return linkTop(nodes.createNode(move(value))); }
+
+    template <typename... Args>
+    T& emplace(Args&&... args) {
+        return linkTop(nodes.createNode(forward<Args>(args)...));
     }
 
     void pop() {
         if (isEmpty()) return;
         Node* temp = top;
         top = top->next;
-        delete temp;
+        nodes.destroyNode(temp);
         size--;
     }
 
-    Complaint topComplaint() const {
-        if (isEmpty()) {
-            cout << "Stack is empty.\n";
-            return Complaint("", false, false, Customer("", "", ""));
-        }
-        return top->data;
-    }
+    // Top element; the stack must not be empty
+    const T& peek() const { return top->data; }
 
     int getSize() const { return size; }
+
+    iterator begin() { return iterator(top); }
+    iterator end() { return iterator(); }
+    const_iterator begin() const { return const_iterator(top); }
+    const_iterator end() const { return const_iterator(); }
 };
-Stack summaryStack;
 
-// Priority queue implemented as a sorted linked list for urgent complaints
+// Priority queue implemented as a sorted linked list. OrderPolicy(a, b) is
+// true when a must come before b; equal elements keep insertion order.
+template <typename T, typename OrderPolicy, typename Alloc = allocator<T>>
 class PriorityQueue {
 public:
     struct Node {
-        int order; // Priority (lower number = higher priority)
-        Complaint data;
+        T data;
         Node* next;
-        Node(int ord, const Complaint& complaint) : order(ord), data(complaint), next(nullptr) {}
+        template <typename... Args>
+        explicit Node(Args&&... args) : data(forward<Args>(args)...), next(nullptr) {}
     };
+    typedef NodeIterator<Node, T> iterator;
+    typedef NodeIterator<const Node, const T> const_iterator;
 
 private:
+    struct Nodes : NodeAllocator<Node, Alloc> {
+        Nodes(const Alloc& alloc) : NodeAllocator<Node, Alloc>(alloc) {}
+        using NodeAllocator<Node, Alloc>::createNode;
+        using NodeAllocator<Node, Alloc>::destroyNode;
+    };
+    Nodes nodes;
+    OrderPolicy before;
     Node* head;
     int size;
 
+    T& linkSorted(Node* newNode) {
+        if (head == nullptr || before(newNode->data, head->data)) {
+            newNode->next = head;
+            head = newNode;
+        } else {
+            Node* current = head;
+            while (current->next != nullptr && !before(newNode->data, current->next->data)) {
+                current = current->next;
+            }
+            newNode->next = current->next;
+            current->next = newNode;
+        }
+        size++;
+        return newNode->data;
+    }
+
 public:
-    PriorityQueue() : head(nullptr), size(0) {}
+    explicit PriorityQueue(const OrderPolicy& policy = OrderPolicy(), const Alloc& alloc = Alloc())
+        : nodes(alloc), before(policy), head(nullptr), size(0) {}
 
     ~PriorityQueue() {
         while (head != nullptr) {
             Node* temp = head;
             head = head->next;
-            delete temp;
+            nodes.destroyNode(temp);
         }
         size = 0;
     }
 
+    PriorityQueue(const PriorityQueue&) = delete;
+    PriorityQueue& operator=(const PriorityQueue&) = delete;
+
     bool isEmpty() const { return size == 0; }
 
-    void insert(int order, const Complaint& complaint) {
-        Node* newNode = new Node(order, complaint);
-        if (head == nullptr || head->order > order) {
-            newNode->next = head;
-            head = newNode;
-        } else {
-            Node* current = head;
-            while (current->next != nullptr && current->next->order <= order) {
-                current = current->next;
-            }
-            newNode->next = current->next;
-            current->next = newNode;
-        }
-        size++;
+    T& insert(const T& value) { return linkSorted(nodes.createNode(value)); }
+    T& insert(T&& value) { return linkSorted(nodes.createNode(move(value))); }
+
+    template <typename... Args>
+    T& emplace(Args&&... args) {
+        return linkSorted(nodes.createNode(forward<Args>(args)...));
     }
 
-    void remove(int id) {
+    // Removes the first element matching pred; returns false if none did
+    template <typename Predicate>
+    bool removeIf(Predicate pred) {
         Node* current = head;
         Node* prev = nullptr;
         while (current != nullptr) {
-            if (current->data.id == id) {
+            if (pred(current->data)) {
                 if (prev == nullptr) {
                     head = current->next;
                 } else {
                     prev->next = current->next;
                 }
-                delete current;
+                nodes.destroyNode(current);
                 size--;
-                cout << "Complaint ID " << id << " removed from priority queue.\n";
-                return;
+                return true;
             }
             prev = current;
             current = current->next;
         }
-        cout << "Complaint ID " << id << " not found in priority queue.\n";
+        return false;
     }
 
-    void display() const {
-        if (isEmpty()) {
-            cout << "No urgent complaints.\n";
-            return;
-        }
-        Node* current = head;
-        cout << "Urgent Complaints:\n";
-        while (current != nullptr) {
-            cout << "-----------------------------------------\n";
-            cout << "Order: " << current->order << "\n";
-            cout << "ID: " << current->data.id << "\n";
-            cout << "Content: " << current->data.content << "\n";
-            cout << "Replied: " << (current->data.replied ? "Yes" : "No") << "\n";
-            cout << "Customer Name: " << current->data.customer.getName() << "\n";
-            cout << "Customer Email: " << current->data.customer.getEmail() << "\n";
-            current = current->next;
+    template <typename Predicate>
+    const T* findIf(Predicate pred) const {
+        for (const T& value : *this) {
+            if (pred(value)) return &value;
         }
-        cout << "-----------------------------------------\n";
+        return nullptr;
     }
+
+    int getSize() const { return size; }
+
+    iterator begin() { return iterator(head); }
+    iterator end() { return iterator(); }
+    const_iterator begin() const { return const_iterator(head); }
+    const_iterator end() const { return const_iterator(); }
 };
-PriorityQueue urgentQueue;
 
-// Linked list for employee management
-class EmployeeList {
+// Singly linked list with insertion at the front
+template <typename T, typename Alloc = allocator<T>>
+class LinkedList {
 public:
     struct Node {
-        Employee employee;
+        T data;
         Node* next;
-        Node(const Employee& emp) : employee(emp), next(nullptr) {}
+        template <typename... Args>
+        explicit Node(Args&&... args) : data(forward<Args>(args)...), next(nullptr) {}
     };
+    typedef NodeIterator<Node, T> iterator;
+    typedef NodeIterator<const Node, const T> const_iterator;
 
 private:
+    struct Nodes : NodeAllocator<Node, Alloc> {
+        Nodes(const Alloc& alloc) : NodeAllocator<Node, Alloc>(alloc) {}
+        using NodeAllocator<Node, Alloc>::createNode;
+        using NodeAllocator<Node, Alloc>::destroyNode;
+    };
+    Nodes nodes;
     Node* head;
+    int size;
+
+    T& linkFront(Node* newNode) {
+        newNode->next = head;
+        head = newNode;
+        size++;
+        return newNode->data;
+    }
 
 public:
-    EmployeeList() : head(nullptr) {}
+    explicit LinkedList(const Alloc& alloc = Alloc()) : nodes(alloc), head(nullptr), size(0) {}
 
-    ~EmployeeList() {
+    ~LinkedList() {
         while (head != nullptr) {
             Node* temp = head;
             head = head->next;
-            delete temp;
+            nodes.destroyNode(temp);
         }
     }
 
-    void addEmployee(const Employee& emp) {
-        Node* newNode = new Node(emp);
-        newNode->next = head;
-        head = newNode;
-        cout << "Employee added successfully!\n";
-    }
+    LinkedList(const LinkedList&) = delete;
+    LinkedList& operator=(const LinkedList&) = delete;
 
-    void displayEmployees() const {
-        if (head == nullptr) {
-            cout << "No employees found.\n";
-            return;
-        }
-        Node* current = head;
-        cout << "Employees List\n================\n";
-        while (current != nullptr) {
-            cout << "Name: " << current->employee.getName() << "\n";
-            cout << "ID: " << current->employee.getId() << "\n";
-            cout << "Password: " << current->employee.getPassword() << "\n";
-            cout << "---------------\n";
-            current = current->next;
-        }
-        cout << "================\n";
+    bool isEmpty() const { return size == 0; }
+
+    T& pushFront(const T& value) { return linkFront(nodes.createNode(value)); }
+    T& pushFront(T&& value) { return linkFront(nodes.createNode(move(value))); }
+
+    template <typename... Args>
+    T& emplaceFront(Args&&... args) {
+        return linkFront(nodes.createNode(forward<Args>(args)...));
     }
 
-    void deleteEmployee(const string& id) {
+    // Removes the first element matching pred; returns false if none did
+    template <typename Predicate>
+    bool removeIf(Predicate pred) {
         Node* current = head;
         Node* prev = nullptr;
         while (current != nullptr) {
-            if (current->employee.getId() == id) {
+            if (pred(current->data)) {
                 if (prev == nullptr) {
                     head = current->next;
                 } else {
                     prev->next = current->next;
                 }
-                delete current;
-                cout << "Employee ID " << id << " deleted successfully!\n";
-                return;
+                nodes.destroyNode(current);
+                size--;
+                return true;
             }
             prev = current;
             current = current->next;
         }
-        cout << "Employee ID " << id << " not found.\n";
+        return false;
     }
+
+    int getSize() const { return size; }
+
+    iterator begin() { return iterator(head); }
+    iterator end() { return iterator(); }
+    const_iterator begin() const { return const_iterator(head); }
+    const_iterator end() const { return const_iterator(); }
 };
-EmployeeList empList;
 
-// Customer functions
-void addNewComplaint() {
-    string name, phone, email, content;
-    cout << "Enter your name: ";
-    getline(cin >> ws, name);
-    cout << "Enter your phone number: ";
-    getline(cin, phone);
-    cout << "Enter your email: ";
-    getline(cin, email);
-    if (email.empty() || email.find('@') == string::npos) {
-        cout << "Invalid email format!\n";
-        return;
-    }
-    cout << "Enter complaint content: ";
-    getline(cin, content);
+// Hot complaint storage
+typedef LinkedQueue<Complaint> ComplaintQueue;
+ComplaintQueue complaintQueue;
+
+// B+tree keys per node; a node spans about one page of keys
+const int BTREE_ORDER = 64;
+
+// Ordered index from complaint ID to its node in complaintQueue. Leaves are
+// chained for range scans; since IDs grow monotonically, a full rightmost
+// node is split at its end so appends leave packed nodes behind. Deletes
+// only free nodes that become empty instead of merging underfull ones.
+class IdIndex {
+public:
+    typedef ComplaintQueue::Node* Value;
+
+private:
+    struct BNode {
+        bool leaf;
+        int count; // Number of keys
+        int keys[BTREE_ORDER + 1];
+        BNode(bool isLeaf) : leaf(isLeaf), count(0) {}
+    };
+
+    struct Leaf : BNode {
+        Value values[BTREE_ORDER + 1];
+        Leaf* next;
+        Leaf* prev;
+        Leaf() : BNode(true), next(nullptr), prev(nullptr) {}
+    };
+
+    struct Inner : BNode {
+        BNode* children[BTREE_ORDER + 2]; // count + 1 children
+        Inner() : BNode(false) {}
+    };
+
+    BNode* root;
+    Leaf* first;
+    int size;
+    unsigned long version; // Bumped on every modification, checked by cursors
+
+    // Index of the first key >= key
+    static int lowerBound(const BNode* node, int key) {
+        return (int)(std::lower_bound(node->keys, node->keys + node->count, key) - node->keys);
+    }
+
+    // Child to descend into for key: keys equal to a separator go right
+    static int childIndex(const BNode* node, int key) {
+        return (int)(std::upper_bound(node->keys, node->keys + node->count, key) - node->keys);
+    }
+
+    Leaf* findLeaf(int key) const {
+        BNode* node = root;
+        while (!node->leaf) {
+            Inner* inner = static_cast<Inner*>(node);
+            node = inner->children[childIndex(inner, key)];
+        }
+        return static_cast<Leaf*>(node);
+    }
+
+    // Split point for an overflowing node: append-heavy rightmost nodes keep
+    // all but the new key, everything else splits in half
+    static int splitPoint(bool rightmost, bool appended) {
+        return (rightmost && appended) ? BTREE_ORDER : (BTREE_ORDER + 1) / 2;
+    }
+
+    // Inserts below node; on overflow returns the new right sibling and
+    // stores the separator key in splitKey
+    BNode* insertInto(BNode* node, int key, Value value, bool rightmost, int& splitKey, bool& inserted) {
+        if (node->leaf) {
+            Leaf* leaf = static_cast<Leaf*>(node);
+            int pos = lowerBound(leaf, key);
+            if (pos < leaf->count && leaf->keys[pos] == key) {
+                leaf->values[pos] = value;
+                inserted = false;
+                return nullptr;
+            }
+            for (int i = leaf->count; i > pos; i--) {
+                leaf->keys[i] = leaf->keys[i - 1];
+                leaf->values[i] = leaf->values[i - 1];
+            }
+            leaf->keys[pos] = key;
+            leaf->values[pos] = value;
+            leaf->count++;
+            inserted = true;
+            if (leaf->count <= BTREE_ORDER) return nullptr;
+
+            int mid = splitPoint(rightmost, pos == leaf->count - 1);
+            Leaf* right = new Leaf();
+            right->count = leaf->count - mid;
+            for (int i = 0; i < right->count; i++) {
+                right->keys[i] = leaf->keys[mid + i];
+                right->values[i] = leaf->values[mid + i];
+            }
+            leaf->count = mid;
+            right->next = leaf->next;
+            right->prev = leaf;
+            if (leaf->next != nullptr) leaf->next->prev = right;
+            leaf->next = right;
+            splitKey = right->keys[0];
+            return right;
+        }
+
+        Inner* inner = static_cast<Inner*>(node);
+        int idx = childIndex(inner, key);
+        int childSplitKey;
+        BNode* newChild = insertInto(inner->children[idx], key, value,
+                                     rightmost && idx == inner->count, childSplitKey, inserted);
+        if (newChild == nullptr) return nullptr;
+
+        for (int i = inner->count; i > idx; i--) {
+            inner->keys[i] = inner->keys[i - 1];
+            inner->children[i + 1] = inner->children[i];
+        }
+        inner->keys[idx] = childSplitKey;
+        inner->children[idx + 1] = newChild;
+        inner->count++;
+        if (inner->count <= BTREE_ORDER) return nullptr;
+
+        // The middle key moves up; the right node takes the keys after it
+        int mid = splitPoint(rightmost, idx == inner->count - 1);
+        if (mid == BTREE_ORDER) mid--;
+        Inner* right = new Inner();
+        splitKey = inner->keys[mid];
+        right->count = inner->count - mid - 1;
+        for (int i = 0; i < right->count; i++) {
+            right->keys[i] = inner->keys[mid + 1 + i];
+        }
+        for (int i = 0; i <= right->count; i++) {
+            right->children[i] = inner->children[mid + 1 + i];
+        }
+        inner->count = mid;
+        return right;
+    }
+
+    // Removes key below node; returns true when node became empty and was
+    // freed by the caller
+    bool eraseFrom(BNode* node, int key, bool& erased) {
+        if (node->leaf) {
+            Leaf* leaf = static_cast<Leaf*>(node);
+            int pos = lowerBound(leaf, key);
+            if (pos == leaf->count || leaf->keys[pos] != key) return false;
+            for (int i = pos; i < leaf->count - 1; i++) {
+                leaf->keys[i] = leaf->keys[i + 1];
+                leaf->values[i] = leaf->values[i + 1];
+            }
+            leaf->count--;
+            erased = true;
+            return leaf->count == 0;
+        }
+
+        Inner* inner = static_cast<Inner*>(node);
+        int idx = childIndex(inner, key);
+        BNode* child = inner->children[idx];
+        if (!eraseFrom(child, key, erased)) return false;
+
+        freeNode(child);
+        if (inner->count == 0) return true; // Its only child is gone
+        int keyIdx = idx > 0 ? idx - 1 : 0;
+        for (int i = keyIdx; i < inner->count - 1; i++) {
+            inner->keys[i] = inner->keys[i + 1];
+        }
+        for (int i = idx; i < inner->count; i++) {
+            inner->children[i] = inner->children[i + 1];
+        }
+        inner->count--;
+        return false;
+    }
+
+    // Frees an emptied node, unlinking leaves from the leaf chain
+    void freeNode(BNode* node) {
+        if (node->leaf) {
+            Leaf* leaf = static_cast<Leaf*>(node);
+            if (leaf->prev != nullptr) leaf->prev->next = leaf->next;
+            if (leaf->next != nullptr) leaf->next->prev = leaf->prev;
+            if (first == leaf) first = leaf->next;
+            delete leaf;
+        } else {
+            delete static_cast<Inner*>(node);
+        }
+    }
+
+    void destroy(BNode* node) {
+        if (node->leaf) {
+            delete static_cast<Leaf*>(node);
+            return;
+        }
+        Inner* inner = static_cast<Inner*>(node);
+        for (int i = 0; i <= inner->count; i++) {
+            destroy(inner->children[i]);
+        }
+        delete inner;
+    }
+
+public:
+    // Forward cursor over keys in ascending order. It remembers the key it is
+    // at and re-seeks after the index changes, so it stays valid across
+    // inserts and deletes, including of the entry it points at: next() then
+    // moves to the first key after the deleted one.
+    class Cursor {
+    private:
+        const IdIndex* index;
+        const Leaf* leaf;
+        int pos;
+        int target; // Key the cursor is at; past the end, the first key wanted
+        unsigned long version;
+
+        void seek() {
+            leaf = index->findLeaf(target);
+            pos = lowerBound(leaf, target);
+            version = index->version;
+            skipEmpty();
+            if (leaf != nullptr) target = leaf->keys[pos];
+        }
+
+        void skipEmpty() {
+            while (leaf != nullptr && pos >= leaf->count) {
+                leaf = leaf->next;
+                pos = 0;
+            }
+        }
+
+        void revalidate() {
+            if (version != index->version) seek();
+        }
+
+    public:
+        Cursor(const IdIndex* idx, int fromKey) : index(idx), leaf(nullptr), pos(0), target(fromKey), version(0) {
+            seek();
+        }
+
+        bool valid() {
+            revalidate();
+            return leaf != nullptr;
+        }
+
+        int key() {
+            revalidate();
+            return leaf->keys[pos];
+        }
+
+        Value value() {
+            revalidate();
+            return leaf->values[pos];
+        }
+
+        void next() {
+            if (leaf == nullptr) return; // Past the end; valid() picks up keys inserted later
+            if (target == numeric_limits<int>::max()) {
+                leaf = nullptr;
+                return;
+            }
+            target++;
+            if (version != index->version) {
+                seek(); // The current key may be gone, so seek past it rather than step
+                return;
+            }
+            pos++;
+            skipEmpty();
+            if (leaf != nullptr) target = leaf->keys[pos];
+        }
+    };
+
+    IdIndex() : root(new Leaf()), size(0), version(0) {
+        first = static_cast<Leaf*>(root);
+    }
+
+    ~IdIndex() { destroy(root); }
+
+    IdIndex(const IdIndex&) = delete;
+    IdIndex& operator=(const IdIndex&) = delete;
+
+    void insert(int key, Value value) {
+        int splitKey;
+        bool inserted = false;
+        BNode* right = insertInto(root, key, value, true, splitKey, inserted);
+        if (right != nullptr) {
+            Inner* newRoot = new Inner();
+            newRoot->count = 1;
+            newRoot->keys[0] = splitKey;
+            newRoot->children[0] = root;
+            newRoot->children[1] = right;
+            root = newRoot;
+        }
+        if (inserted) size++;
+        version++;
+    }
+
+    bool erase(int key) {
+        bool erased = false;
+        if (eraseFrom(root, key, erased)) {
+            // The whole tree emptied out; keep a single empty leaf as root
+            if (!root->leaf) {
+                freeNode(root);
+                root = first = new Leaf();
+            }
+        }
+        while (!root->leaf && root->count == 0) {
+            Inner* oldRoot = static_cast<Inner*>(root);
+            root = oldRoot->children[0];
+            delete oldRoot;
+        }
+        if (erased) {
+            size--;
+            version++;
+        }
+        return erased;
+    }
+
+    Value find(int key) const {
+        const Leaf* leaf = findLeaf(key);
+        int pos = lowerBound(leaf, key);
+        if (pos < leaf->count && leaf->keys[pos] == key) return leaf->values[pos];
+        return nullptr;
+    }
+
+    // Cursor positioned at the first key >= key
+    Cursor seek(int key) const { return Cursor(this, key); }
+
+    // Calls visit(key, value) for every key in [from, to] in order
+    template <typename Visitor>
+    void scan(int from, int to, Visitor visit) const {
+        const Leaf* leaf = findLeaf(from);
+        int pos = lowerBound(leaf, from);
+        while (leaf != nullptr) {
+            for (; pos < leaf->count; pos++) {
+                if (leaf->keys[pos] > to) return;
+                visit(leaf->keys[pos], leaf->values[pos]);
+            }
+            leaf = leaf->next;
+            pos = 0;
+        }
+    }
+
+    int getSize() const { return size; }
+};
+IdIndex complaintIndex;
+
+// Constructs a complaint at the back of the hot queue and indexes it
+template <typename... Args>
+Complaint* emplaceComplaint(Args&&... args) {
+    Complaint& complaint = complaintQueue.emplace(forward<Args>(args)...);
+    complaintIndex.insert(complaint.id, complaintQueue.getRearNode());
+    return &complaint;
+}
+
+// Removes a hot complaint from the queue and the ID index
+void removeHotComplaint(ComplaintQueue::Node* node) {
+    complaintIndex.erase(node->data.id);
+    complaintQueue.remove(node);
+}
+
+// Tiered storage settings
+const int SEGMENT_SPAN = 1000;        // Complaint IDs covered by one cold segment file
+const int SEGMENT_CACHE_CAPACITY = 8; // Cold segments kept resident at once
+const int RECENT_WINDOW = 100;        // Newest complaint IDs always stay hot
+const string SEGMENT_DIR = "complaint_segments";
+
+// Cold tier: replied complaints that are neither urgent nor recent live in
+// ID-range segment files and are paged back in through an LRU segment cache
+class ColdStore {
+public:
+    struct Segment {
+        vector<Complaint> records; // Sorted by ID
+        bool dirty;
+        Segment() : dirty(false) {}
+    };
+
+private:
+    map<int, int> segmentCounts; // Segment number -> record count (the manifest)
+    list<int> lru;               // Cached segment numbers, most recent first
+    unordered_map<int, pair<Segment, list<int>::iterator>> cache;
+    int count;
+    long hits;
+    long misses;
+
+    static int segmentOf(int id) { return (id - 1) / SEGMENT_SPAN; }
+
+    string segmentPath(int seg) const {
+        return SEGMENT_DIR + "/segment_" + to_string(seg) + ".txt";
+    }
+
+    void writeSegment(int seg, Segment& segment) {
+        if (!segment.dirty) return;
+        filesystem::create_directories(SEGMENT_DIR);
+        if (segment.records.empty()) {
+            filesystem::remove(segmentPath(seg));
+        } else {
+            ofstream outFile(segmentPath(seg));
+            writeDataFileHeader(outFile);
+            for (const Complaint& complaint : segment.records) {
+                writeComplaintRecord(outFile, complaint);
+            }
+        }
+        segment.dirty = false;
+    }
+
+    // Returns the segment, reading it from disk and evicting the least
+    // recently used clean segment when it is not cached. Dirty segments stay
+    // cached until flush(), so segment files only change together with the
+    // manifest and the hot file; the cache grows past its capacity meanwhile.
+    Segment& loadSegment(int seg) {
+        auto it = cache.find(seg);
+        if (it != cache.end()) {
+            hits++;
+            lru.splice(lru.begin(), lru, it->second.second);
+            return it->second.first;
+        }
+        misses++;
+        if ((int)cache.size() >= SEGMENT_CACHE_CAPACITY) {
+            for (auto victim = lru.rbegin(); victim != lru.rend(); ++victim) {
+                if (!cache[*victim].first.dirty) {
+                    cache.erase(*victim);
+                    lru.erase(next(victim).base());
+                    break;
+                }
+            }
+        }
+        lru.push_front(seg);
+        auto& entry = cache[seg];
+        entry.second = lru.begin();
+        ifstream inFile(segmentPath(seg));
+        int version = readDataFileHeader(inFile);
+        Complaint complaint;
+        while (inFile.is_open() && readComplaintRecord(inFile, complaint, version)) {
+            entry.first.records.push_back(complaint);
+        }
+        return entry.first;
+    }
+
+    static vector<Complaint>::iterator lowerBound(Segment& segment, int id) {
+        return lower_bound(segment.records.begin(), segment.records.end(), id,
+                           [](const Complaint& c, int key) { return c.id < key; });
+    }
+
+public:
+    ColdStore() : count(0), hits(0), misses(0) {}
+
+    // Reads the manifest; segments themselves are only read on demand
+    void open() {
+        ifstream inFile(SEGMENT_DIR + "/manifest.txt");
+        if (!inFile.is_open()) return;
+        int lastId, seg, records;
+        if (inFile >> lastId && lastId > Complaint::lastId) {
+            Complaint::lastId = lastId;
+        }
+        while (inFile >> seg >> records) {
+            segmentCounts[seg] = records;
+            count += records;
+        }
+    }
+
+    // Moves a complaint into its cold segment
+    void evict(const Complaint& complaint) {
+        int seg = segmentOf(complaint.id);
+        Segment& segment = loadSegment(seg);
+        auto it = lowerBound(segment, complaint.id);
+        if (it != segment.records.end() && it->id == complaint.id) {
+            *it = complaint;
+        } else {
+            segment.records.insert(it, complaint);
+            segmentCounts[seg]++;
+            count++;
+        }
+        segment.dirty = true;
+    }
+
+    // Returns the cold complaint with this ID, or nullptr. The pointer stays
+    // valid until the next ColdStore call; pass forWrite when modifying it.
+    Complaint* find(int id, bool forWrite = false) {
+        if (id <= 0) return nullptr;
+        int seg = segmentOf(id);
+        if (segmentCounts.find(seg) == segmentCounts.end()) return nullptr;
+        Segment& segment = loadSegment(seg);
+        auto it = lowerBound(segment, id);
+        if (it == segment.records.end() || it->id != id) return nullptr;
+        if (forWrite) segment.dirty = true;
+        return &*it;
+    }
+
+    bool remove(int id) {
+        if (find(id) == nullptr) return false;
+        int seg = segmentOf(id);
+        Segment& segment = loadSegment(seg);
+        segment.records.erase(lowerBound(segment, id));
+        segment.dirty = true;
+        if (--segmentCounts[seg] == 0) segmentCounts.erase(seg);
+        count--;
+        return true;
+    }
+
+    // Calls visit(const Complaint&) for every cold complaint in ID order
+    template <typename Visitor>
+    void forEach(Visitor visit) {
+        vector<int> segments;
+        for (const auto& entry : segmentCounts) segments.push_back(entry.first);
+        for (int seg : segments) {
+            for (const Complaint& complaint : loadSegment(seg).records) {
+                visit(complaint);
+            }
+        }
+    }
+
+    // Returns up to limit cold complaints with IDs in [from, to], in order
+    vector<Complaint> collectRange(int from, int to, size_t limit) {
+        vector<Complaint> result;
+        for (auto it = segmentCounts.lower_bound(segmentOf(max(from, 1)));
+             it != segmentCounts.end() && result.size() < limit; ++it) {
+            int seg = it->first;
+            if (seg > segmentOf(max(to, 1))) break;
+            Segment& segment = loadSegment(seg);
+            for (auto rec = lowerBound(segment, from);
+                 rec != segment.records.end() && rec->id <= to && result.size() < limit; ++rec) {
+                result.push_back(*rec);
+            }
+        }
+        return result;
+    }
+
+    // Writes dirty segments and the manifest, then shrinks the cache back to
+    // its capacity
+    void flush() {
+        for (auto& entry : cache) {
+            writeSegment(entry.first, entry.second.first);
+        }
+        while ((int)cache.size() > SEGMENT_CACHE_CAPACITY) {
+            cache.erase(lru.back());
+            lru.pop_back();
+        }
+        if (count == 0 && !filesystem::exists(SEGMENT_DIR)) return;
+        filesystem::create_directories(SEGMENT_DIR);
+        ofstream outFile(SEGMENT_DIR + "/manifest.txt");
+        outFile << Complaint::lastId << "\n";
+        for (const auto& entry : segmentCounts) {
+            outFile << entry.first << " " << entry.second << "\n";
+        }
+    }
+
+    // Paths of the segment files that are current on disk; the records of
+    // segments with unsaved changes are added to inMemory instead
+    vector<string> getSegmentFiles(vector<const Complaint*>& inMemory) const {
+        vector<string> files;
+        for (const auto& entry : segmentCounts) {
+            auto cached = cache.find(entry.first);
+            if (cached == cache.end() || !cached->second.first.dirty) {
+                files.push_back(segmentPath(entry.first));
+                continue;
+            }
+            for (const Complaint& complaint : cached->second.first.records) inMemory.push_back(&complaint);
+        }
+        return files;
+    }
+
+    int getDirtySegments() const {
+        int dirty = 0;
+        for (const auto& entry : cache) dirty += entry.second.first.dirty;
+        return dirty;
+    }
+
+    int getCount() const { return count; }
+    int getSegmentCount() const { return (int)segmentCounts.size(); }
+    int getCachedSegments() const { return (int)cache.size(); }
+    long getHits() const { return hits; }
+    long getMisses() const { return misses; }
+};
+ColdStore coldStore;
+
+// Unreplied, urgent and recent complaints stay resident in complaintQueue
+bool isHotComplaint(const Complaint& complaint) {
+    return !complaint.replied || complaint.urgent ||
+           complaint.id > Complaint::lastId - RECENT_WINDOW;
+}
+
+// Looks a complaint up in the hot index first, then pages in its cold segment
+Complaint* findComplaint(int id, bool forWrite = false) {
+    ComplaintQueue::Node* node = complaintIndex.find(id);
+    if (node != nullptr) return &node->data;
+    return coldStore.find(id, forWrite);
+}
+
+// Returns the hot copy of a complaint, paging it back out of the cold tier
+// into complaintQueue if necessary
+Complaint* promoteComplaint(int id) {
+    ComplaintQueue::Node* node = complaintIndex.find(id);
+    if (node != nullptr) return &node->data;
+    Complaint* cold = coldStore.find(id);
+    if (cold == nullptr) return nullptr;
+    Complaint* hot = emplaceComplaint(move(*cold));
+    coldStore.remove(id);
+    return hot;
+}
+
+// Moves every complaint that is no longer hot into the cold tier
+void evictColdComplaints() {
+    ComplaintQueue::Node* current = complaintQueue.getFrontNode();
+    while (current != nullptr) {
+        ComplaintQueue::Node* next = current->next;
+        if (!isHotComplaint(current->data)) {
+            coldStore.evict(current->data);
+            removeHotComplaint(current);
+        }
+        current = next;
+    }
+}
+
+// Writes the cold segments, the manifest and the hot file in one step, so
+// the files on disk always describe the same store; false if the hot file
+// cannot be written
+bool writeComplaintData() {
+    evictColdComplaints();
+    coldStore.flush();
+    ofstream outFile("complaint_data.txt");
+    if (!outFile.is_open()) return false;
+    writeDataFileHeader(outFile);
+    for (const Complaint& complaint : complaintQueue) {
+        writeComplaintRecord(outFile, complaint);
+    }
+    return true;
+}
+
+void showStorageStats(ostream& out = cout) {
+    out << "=========================================\n";
+    out << "Storage Stats\n";
+    out << "Hot (in memory): " << complaintQueue.getSize() << "\n";
+    out << "Cold (on disk): " << coldStore.getCount() << " in "
+        << coldStore.getSegmentCount() << " segment(s)\n";
+    out << "Cached segments: " << coldStore.getCachedSegments() << "/"
+        << SEGMENT_CACHE_CAPACITY << " (" << coldStore.getDirtySegments() << " with unsaved changes)\n";
+    out << "Segment cache hits: " << coldStore.getHits()
+        << ", misses: " << coldStore.getMisses() << "\n";
+    out << "=========================================\n";
+}
+
+// Lower-cased part of an email address after the '@'
+string emailDomain(const string& email) {
+    size_t at = email.find('@');
+    string domain = at == string::npos ? "(none)" : email.substr(at + 1);
+    transform(domain.begin(), domain.end(), domain.begin(), ::tolower);
+    return domain;
+}
+
+// Compressed bitmap of 32-bit values in the style of Roaring bitmaps: values
+// are grouped by their high 16 bits, and each group is a sorted array while
+// it holds at most 4096 values and a 65536-bit bitmap once it is denser
+class RoaringBitmap {
+private:
+    static const int ARRAY_LIMIT = 4096;
+    static const int BITMAP_WORDS = 65536 / 64;
+
+    struct Container {
+        vector<uint16_t> array; // Sorted values while sparse
+        vector<uint64_t> bits;  // BITMAP_WORDS words once dense, else empty
+        int cardinality;
+
+        Container() : cardinality(0) {}
+
+        bool isBitmap() const { return !bits.empty(); }
+
+        bool contains(uint16_t low) const {
+            if (isBitmap()) return (bits[low >> 6] >> (low & 63)) & 1;
+            return binary_search(array.begin(), array.end(), low);
+        }
+
+        // Switches to the representation that suits the cardinality
+        void normalize() {
+            if (isBitmap() && cardinality <= ARRAY_LIMIT) {
+                array.clear();
+                forEach([&](uint16_t low) { array.push_back(low); });
+                bits.clear();
+            } else if (!isBitmap() && cardinality > ARRAY_LIMIT) {
+                bits.assign(BITMAP_WORDS, 0);
+                for (uint16_t low : array) bits[low >> 6] |= 1ULL << (low & 63);
+                array.clear();
+            }
+        }
+
+        template <typename Visitor>
+        void forEach(Visitor visit) const {
+            if (!isBitmap()) {
+                for (uint16_t low : array) visit(low);
+                return;
+            }
+            for (int word = 0; word < BITMAP_WORDS; word++) {
+                uint64_t w = bits[word];
+                while (w != 0) {
+                    uint64_t lowest = w & (~w + 1);
+                    int bit = (int)bitset<64>(lowest - 1).count(); // Trailing zeros
+                    visit((uint16_t)(word * 64 + bit));
+                    w ^= lowest;
+                }
+            }
+        }
+    };
+
+    enum Operation { AND, OR, ANDNOT };
+
+    vector<pair<uint16_t, Container>> containers; // Sorted by high 16 bits
+
+    vector<pair<uint16_t, Container>>::iterator findContainer(uint16_t high) {
+        return lower_bound(containers.begin(), containers.end(), high,
+                           [](const pair<uint16_t, Container>& entry, uint16_t key) { return entry.first < key; });
+    }
+
+    static vector<uint64_t> toWords(const Container& c) {
+        if (c.isBitmap()) return c.bits;
+        vector<uint64_t> words(BITMAP_WORDS, 0);
+        for (uint16_t low : c.array) words[low >> 6] |= 1ULL << (low & 63);
+        return words;
+    }
+
+    // Combines two containers; dense inputs are processed 64 values per word
+    static Container combine(const Container& a, const Container& b, Operation op) {
+        Container result;
+        if (!a.isBitmap() && !b.isBitmap()) {
+            auto out = back_inserter(result.array);
+            if (op == AND) set_intersection(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), out);
+            if (op == OR) set_union(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), out);
+            if (op == ANDNOT) set_difference(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), out);
+            result.cardinality = (int)result.array.size();
+        } else if (op != OR && !a.isBitmap()) {
+            // Sparse left side: probe each value against the bitmap
+            for (uint16_t low : a.array) {
+                if (b.contains(low) == (op == AND)) result.array.push_back(low);
+            }
+            result.cardinality = (int)result.array.size();
+        } else {
+            result.bits = toWords(a);
+            vector<uint64_t> other = toWords(b);
+            for (int word = 0; word < BITMAP_WORDS; word++) {
+                if (op == AND) result.bits[word] &= other[word];
+                if (op == OR) result.bits[word] |= other[word];
+                if (op == ANDNOT) result.bits[word] &= ~other[word];
+                result.cardinality += (int)bitset<64>(result.bits[word]).count();
+            }
+        }
+        result.normalize();
+        return result;
+    }
+
+    static RoaringBitmap combine(const RoaringBitmap& a, const RoaringBitmap& b, Operation op) {
+        RoaringBitmap result;
+        size_t i = 0, j = 0;
+        while (i < a.containers.size() || j < b.containers.size()) {
+            bool takeA = j == b.containers.size() ||
+                         (i < a.containers.size() && a.containers[i].first < b.containers[j].first);
+            bool takeB = i == a.containers.size() ||
+                         (j < b.containers.size() && b.containers[j].first < a.containers[i].first);
+            if (takeA) {
+                if (op != AND) result.containers.push_back(a.containers[i]);
+                i++;
+            } else if (takeB) {
+                if (op == OR) result.containers.push_back(b.containers[j]);
+                j++;
+            } else {
+                Container c = combine(a.containers[i].second, b.containers[j].second, op);
+                if (c.cardinality > 0) result.containers.push_back({a.containers[i].first, c});
+                i++;
+                j++;
+            }
+        }
+        return result;
+    }
+
+public:
+    void add(uint32_t value) {
+        uint16_t high = value >> 16, low = value & 0xFFFF;
+        auto it = findContainer(high);
+        if (it == containers.end() || it->first != high) it = containers.insert(it, {high, Container()});
+        Container& c = it->second;
+        if (c.isBitmap()) {
+            uint64_t mask = 1ULL << (low & 63);
+            if (c.bits[low >> 6] & mask) return;
+            c.bits[low >> 6] |= mask;
+        } else {
+            auto pos = lower_bound(c.array.begin(), c.array.end(), low);
+            if (pos != c.array.end() && *pos == low) return;
+            c.array.insert(pos, low);
+        }
+        c.cardinality++;
+        c.normalize();
+    }
+
+    void remove(uint32_t value) {
+        uint16_t high = value >> 16, low = value & 0xFFFF;
+        auto it = findContainer(high);
+        if (it == containers.end() || it->first != high || !it->second.contains(low)) return;
+        Container& c = it->second;
+        if (c.isBitmap()) {
+            c.bits[low >> 6] &= ~(1ULL << (low & 63));
+        } else {
+            c.array.erase(lower_bound(c.array.begin(), c.array.end(), low));
+        }
+        c.cardinality--;
+        if (c.cardinality == 0) {
+            containers.erase(it);
+        } else {
+            c.normalize();
+        }
+    }
+
+    bool contains(uint32_t value) const {
+        uint16_t high = value >> 16;
+        auto it = lower_bound(containers.begin(), containers.end(), high,
+                              [](const pair<uint16_t, Container>& entry, uint16_t key) { return entry.first < key; });
+        return it != containers.end() && it->first == high && it->second.contains(value & 0xFFFF);
+    }
+
+    void set(uint32_t value, bool on) {
+        if (on) {
+            add(value);
+        } else {
+            remove(value);
+        }
+    }
+
+    RoaringBitmap operator&(const RoaringBitmap& other) const { return combine(*this, other, AND); }
+    RoaringBitmap operator|(const RoaringBitmap& other) const { return combine(*this, other, OR); }
+    RoaringBitmap andNot(const RoaringBitmap& other) const { return combine(*this, other, ANDNOT); }
+
+    long cardinality() const {
+        long total = 0;
+        for (const auto& entry : containers) total += entry.second.cardinality;
+        return total;
+    }
+
+    // Calls visit(value) for every value in ascending order
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        for (const auto& entry : containers) {
+            uint32_t high = (uint32_t)entry.first << 16;
+            entry.second.forEach([&](uint16_t low) { visit(high | low); });
+        }
+    }
+
+    size_t memoryBytes() const {
+        size_t bytes = containers.capacity() * sizeof(containers[0]);
+        for (const auto& entry : containers) {
+            bytes += entry.second.array.capacity() * sizeof(uint16_t) + entry.second.bits.capacity() * sizeof(uint64_t);
+        }
+        return bytes;
+    }
+};
+
+// Bitmap indexes over every complaint ID (hot and cold) for the replied,
+// urgent and summarized flags and for each interned email domain. Built on
+// the first filter query, then kept current by the store's mutations.
+class FilterIndex {
+private:
+    bool built;
+    int indexedThrough; // Last ID covered by a build that is still in progress
+    RoaringBitmap all;
+    RoaringBitmap replied;
+    RoaringBitmap urgent;
+    RoaringBitmap summarized;
+    unordered_map<string, int> domainIds;
+    vector<RoaringBitmap> domains;
+
+    int internDomain(const string& domain) {
+        auto it = domainIds.find(domain);
+        if (it != domainIds.end()) return it->second;
+        domainIds[domain] = (int)domains.size();
+        domains.push_back(RoaringBitmap());
+        return (int)domains.size() - 1;
+    }
+
+    void index(const Complaint& complaint) {
+        uint32_t id = (uint32_t)complaint.id;
+        all.add(id);
+        replied.set(id, complaint.replied);
+        urgent.set(id, complaint.urgent);
+        summarized.set(id, !complaint.summarizedBy.empty());
+        domains[internDomain(emailDomain(complaint.customer.getEmail()))].add(id);
+    }
+
+public:
+    FilterIndex() : built(false), indexedThrough(0) {}
+
+    bool isBuilt() const { return built; }
+    int getIndexedThrough() const { return indexedThrough; }
+
+    // Indexes hot and cold complaints; cold segments are read once here
+    template <typename ForEachComplaint>
+    void build(ForEachComplaint forEachComplaint) {
+        forEachComplaint([&](const Complaint& complaint) { index(complaint); });
+        built = true;
+    }
+
+    // Indexes the next page of a build spread over several calls. Pages come
+    // in ID order; changes to IDs not reached yet are picked up by later pages.
+    void buildPage(const vector<Complaint>& page, bool last) {
+        for (const Complaint& complaint : page) index(complaint);
+        if (!page.empty()) indexedThrough = page.back().id;
+        built = last;
+    }
+
+    // Records a new complaint or a change to its flags
+    void update(const Complaint& complaint) {
+        if (built || complaint.id <= indexedThrough) index(complaint);
+    }
+
+    void remove(const Complaint& complaint) {
+        if (!built && complaint.id > indexedThrough) return;
+        uint32_t id = (uint32_t)complaint.id;
+        all.remove(id);
+        replied.remove(id);
+        urgent.remove(id);
+        summarized.remove(id);
+        auto it = domainIds.find(emailDomain(complaint.customer.getEmail()));
+        if (it != domainIds.end()) domains[it->second].remove(id);
+    }
+
+    const RoaringBitmap& allIds() const { return all; }
+    const RoaringBitmap& repliedIds() const { return replied; }
+    const RoaringBitmap& urgentIds() const { return urgent; }
+    const RoaringBitmap& summarizedIds() const { return summarized; }
+
+    RoaringBitmap domainIdsFor(const string& domain) const {
+        auto it = domainIds.find(domain);
+        return it == domainIds.end() ? RoaringBitmap() : domains[it->second];
+    }
+
+    int getDomainCount() const { return (int)domains.size(); }
+
+    size_t memoryBytes() const {
+        size_t bytes = all.memoryBytes() + replied.memoryBytes() + urgent.memoryBytes() + summarized.memoryBytes();
+        for (const RoaringBitmap& bitmap : domains) bytes += bitmap.memoryBytes();
+        return bytes;
+    }
+};
+FilterIndex filterIndex;
+
+// Evaluates filter expressions over the bitmap indexes, for example
+//   unreplied AND urgent AND NOT summarized AND domain=example.com
+// Terms are all, replied, unreplied, urgent, summarized and domain=<domain>;
+// NOT binds tightest, then AND, then OR, and parentheses group.
+class FilterQuery {
+private:
+    const FilterIndex& index;
+    vector<string> tokens;
+    size_t pos;
+    string error;
+
+    bool accept(const string& token) {
+        if (pos < tokens.size() && tokens[pos] == token) {
+            pos++;
+            return true;
+        }
+        return false;
+    }
+
+    RoaringBitmap parseOr() {
+        RoaringBitmap result = parseAnd();
+        while (error.empty() && accept("or")) result = result | parseAnd();
+        return result;
+    }
+
+    RoaringBitmap parseAnd() {
+        RoaringBitmap result = parseNot();
+        while (error.empty() && accept("and")) result = result & parseNot();
+        return result;
+    }
+
+    RoaringBitmap parseNot() {
+        if (accept("not")) return index.allIds().andNot(parseNot());
+        return parseTerm();
+    }
+
+    RoaringBitmap parseTerm() {
+        if (pos == tokens.size()) {
+            error = "Unexpected end of filter.";
+            return RoaringBitmap();
+        }
+        string token = tokens[pos++];
+        if (token == "(") {
+            RoaringBitmap result = parseOr();
+            if (error.empty() && !accept(")")) error = "Missing ')'.";
+            return result;
+        }
+        if (token == "all") return index.allIds();
+        if (token == "replied") return index.repliedIds();
+        if (token == "unreplied") return index.allIds().andNot(index.repliedIds());
+        if (token == "urgent") return index.urgentIds();
+        if (token == "summarized") return index.summarizedIds();
+        if (token.compare(0, 7, "domain=") == 0 && token.size() > 7) return index.domainIdsFor(token.substr(7));
+        error = "Unknown filter term: " + token;
+        return RoaringBitmap();
+    }
+
+public:
+    FilterQuery(const FilterIndex& idx) : index(idx), pos(0) {}
+
+    // Returns false and sets errorMessage when the expression is invalid
+    bool evaluate(const string& expression, RoaringBitmap& result, string& errorMessage) {
+        string spaced;
+        for (char c : expression) {
+            if (c == '(' || c == ')') {
+                spaced += ' ';
+                spaced += c;
+                spaced += ' ';
+            } else {
+                spaced += (char)tolower((unsigned char)c);
+            }
+        }
+        istringstream words(spaced);
+        tokens.clear();
+        for (string token; words >> token;) tokens.push_back(token);
+        pos = 0;
+        error.clear();
+        result = parseOr();
+        if (error.empty() && pos < tokens.size()) error = "Unexpected '" + tokens[pos] + "'.";
+        errorMessage = error;
+        return error.empty();
+    }
+};
+
+// Stack for storing problem summaries
+Stack<Complaint> summaryStack;
+
+// Urgent queue ordering: lower order number = higher priority. Orders start
+// at MIN_URGENT_ORDER; 0 means a complaint has no place in the queue, so
+// lower orders are refused wherever they are entered.
+const int MIN_URGENT_ORDER = 1;
+const string URGENT_ORDER_ERROR = "Priority order must be 1 or more.";
+
+struct ByUrgentOrder {
+    bool operator()(const Complaint& a, const Complaint& b) const { return a.order < b.order; }
+};
+
+// Priority queue implemented as a sorted linked list for urgent complaints
+PriorityQueue<Complaint, ByUrgentOrder> urgentQueue;
+
+// Queues the complaint at its order, or moves it up if it is already queued
+// with a larger order; returns false when nothing changed
+bool raiseUrgentOrder(const Complaint& complaint) {
+    auto sameId = [&](const Complaint& queued) { return queued.id == complaint.id; };
+    const Complaint* queued = urgentQueue.findIf(sameId);
+    if (queued != nullptr) {
+        if (queued->order <= complaint.order) return false;
+        urgentQueue.removeIf(sameId);
+    }
+    urgentQueue.insert(complaint);
+    return true;
+}
+
+// Queues a complaint read back from a file, a snapshot or an import if it is
+// urgent. Orders below MIN_URGENT_ORDER, from files written before they were
+// refused or imports without an order, are raised to it.
+void restoreUrgent(Complaint& complaint) {
+    if (!complaint.urgent) return;
+    complaint.order = max(complaint.order, MIN_URGENT_ORDER);
+    urgentQueue.insert(complaint);
+}
+
+// Queues the complaint at its current order, replacing any entry it already has
+void requeueUrgent(const Complaint& complaint) {
+    urgentQueue.removeIf([&](const Complaint& queued) { return queued.id == complaint.id; });
+    urgentQueue.insert(complaint);
+}
+
+void showUrgentComplaints(ostream& out = cout) {
+    if (urgentQueue.isEmpty()) {
+        out << "No urgent complaints.\n";
+        return;
+    }
+    out << "Urgent Complaints:\n";
+    for (const Complaint& complaint : urgentQueue) {
+        out << "-----------------------------------------\n";
+        out << "Order: " << complaint.order << "\n";
+        out << "ID: " << complaint.id << "\n";
+        out << "Content: " << complaint.content << "\n";
+        out << "Replied: " << (complaint.replied ? "Yes" : "No") << "\n";
+        out << "Customer Name: " << complaint.customer.getName() << "\n";
+        out << "Customer Email: " << complaint.customer.getEmail() << "\n";
+    }
+    out << "-----------------------------------------\n";
+}
+
+// Linked list for employee management
+LinkedList<Employee> empList;
+
+// Timer wheel settings: 4 levels of 64 one-minute slots span about 31 years
+const int WHEEL_TICK_SECONDS = 60;
+const int WHEEL_BITS = 6;
+const int WHEEL_SLOTS = 1 << WHEEL_BITS;
+const int WHEEL_LEVELS = 4;
+
+// Hierarchical timer wheel. Level 0 holds timers due within the next 64
+// ticks, one slot per tick; each higher level covers 64 times the span of the
+// one below. Scheduling and firing are O(1); a higher-level slot is cascaded
+// down once each time the level below wraps around.
+class TimerWheel {
+public:
+    struct Timer {
+        int complaintId;
+        int stage;     // Index of the SLA stage this timer escalates to
+        long expires;  // Tick at which the timer fires
+        Timer* next;
+        Timer(int id, int stg, long exp) : complaintId(id), stage(stg), expires(exp), next(nullptr) {}
+    };
+
+private:
+    Timer* slots[WHEEL_LEVELS][WHEEL_SLOTS];
+    Timer* due; // Timers scheduled in the past; fired on the next advance
+    long now;   // Last processed tick
+    int pending;
+
+    void place(Timer* timer) {
+        long delta = timer->expires - now;
+        if (delta <= 0) {
+            timer->next = due;
+            due = timer;
+            return;
+        }
+        int level = 0;
+        while (level < WHEEL_LEVELS - 1 && delta >= (1L << (WHEEL_BITS * (level + 1)))) {
+            level++;
+        }
+        long maxSpan = 1L << (WHEEL_BITS * WHEEL_LEVELS);
+        long expires = delta < maxSpan ? timer->expires : now + maxSpan - 1;
+        int slot = (int)((expires >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1));
+        timer->next = slots[level][slot];
+        slots[level][slot] = timer;
+    }
+
+    // Re-places every timer of a higher-level slot into the levels below
+    void cascade(int level) {
+        int slot = (int)((now >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1));
+        Timer* timer = slots[level][slot];
+        slots[level][slot] = nullptr;
+        while (timer != nullptr) {
+            Timer* next = timer->next;
+            place(timer);
+            timer = next;
+        }
+    }
+
+    template <typename Callback>
+    void fireList(Timer* timer, Callback fire) {
+        while (timer != nullptr) {
+            Timer* next = timer->next;
+            pending--;
+            if (timer->expires <= now) {
+                fire(timer->complaintId, timer->stage);
+                delete timer;
+            } else {
+                place(timer); // Clamped timer beyond the wheel's span
+                pending++;
+            }
+            timer = next;
+        }
+    }
+
+    static void freeList(Timer* timer) {
+        while (timer != nullptr) {
+            Timer* next = timer->next;
+            delete timer;
+            timer = next;
+        }
+    }
+
+public:
+    TimerWheel() : due(nullptr), now(0), pending(0) {
+        for (int level = 0; level < WHEEL_LEVELS; level++) {
+            for (int slot = 0; slot < WHEEL_SLOTS; slot++) {
+                slots[level][slot] = nullptr;
+            }
+        }
+    }
+
+    ~TimerWheel() { clear(); }
+
+    static long tickOf(time_t t) { return (long)(t / WHEEL_TICK_SECONDS); }
+
+    // Drops all timers and restarts the wheel at tick
+    void reset(long tick) {
+        clear();
+        now = tick;
+    }
+
+    void clear() {
+        for (int level = 0; level < WHEEL_LEVELS; level++) {
+            for (int slot = 0; slot < WHEEL_SLOTS; slot++) {
+                freeList(slots[level][slot]);
+                slots[level][slot] = nullptr;
+            }
+        }
+        freeList(due);
+        due = nullptr;
+        pending = 0;
+    }
+
+    void schedule(int complaintId, int stage, long expires) {
+        place(new Timer(complaintId, stage, expires));
+        pending++;
+    }
+
+    // Processes every tick up to and including tick, calling
+    // fire(complaintId, stage) for each expired timer
+    template <typename Callback>
+    void advance(long tick, Callback fire) {
+        if (pending == 0 && now < tick) now = tick; // Nothing to fire on the way
+        Timer* overdue = due;
+        due = nullptr;
+        fireList(overdue, fire);
+        while (now < tick) {
+            now++;
+            for (int level = 1; level < WHEEL_LEVELS; level++) {
+                if (((now >> (WHEEL_BITS * (level - 1))) & (WHEEL_SLOTS - 1)) != 0) break;
+                cascade(level);
+            }
+            int slot = (int)(now & (WHEEL_SLOTS - 1));
+            Timer* expired = slots[0][slot];
+            slots[0][slot] = nullptr;
+            fireList(expired, fire);
+            overdue = due;
+            due = nullptr;
+            fireList(overdue, fire);
+        }
+    }
+
+    int getPending() const { return pending; }
+};
+TimerWheel slaWheel;
+// Where escalations are announced. Only the interactive menu sets this; the
+// server, replicas and --export/--import escalate silently.
+ostream* slaNotices = nullptr;
+
+// SLA escalation stages: an unreplied complaint older than hours is marked
+// urgent and queued at order (lower = higher priority). Ages must increase.
+struct SlaStage {
+    int hours;
+    int order;
+};
+const int SLA_STAGE_COUNT = 3;
+SlaStage slaStages[SLA_STAGE_COUNT] = {{24, 3}, {48, 2}, {72, 1}};
+
+// Schedules the SLA timer for the first stage after fromStage, if any
+void scheduleSlaTimer(const Complaint& complaint, int fromStage) {
+    int stage = fromStage + 1;
+    if (complaint.replied || complaint.createdAt == 0 || stage >= SLA_STAGE_COUNT) return;
+    time_t dueAt = complaint.createdAt + (time_t)slaStages[stage].hours * 3600;
+    slaWheel.schedule(complaint.id, stage, TimerWheel::tickOf(dueAt));
+}
+
+// Timer callback: escalates a still-open complaint to the furthest stage its
+// age has reached and schedules the next one. Timers for complaints that were
+// replied to or deleted in the meantime are simply dropped here, as are those
+// left by a deleted complaint whose ID an import reused.
+void escalateComplaint(int complaintId, int stage) {
+    ComplaintQueue::Node* node = complaintIndex.find(complaintId);
+    if (node == nullptr || node->data.replied) return;
+    Complaint& complaint = node->data;
+    time_t now = time(nullptr);
+    time_t dueAt = complaint.createdAt + (time_t)slaStages[stage].hours * 3600;
+    if (TimerWheel::tickOf(dueAt) > TimerWheel::tickOf(now)) return;
+    time_t age = now - complaint.createdAt;
+    while (stage + 1 < SLA_STAGE_COUNT && age >= (time_t)slaStages[stage + 1].hours * 3600) {
+        stage++;
+    }
+    complaint.urgent = true;
+    if (complaint.order == 0 || slaStages[stage].order < complaint.order) {
+        complaint.order = slaStages[stage].order;
+    }
+    filterIndex.update(complaint);
+    changeLog.record("ESCALATE", to_string(complaintId) + '|' + to_string(complaint.order));
+    if (raiseUrgentOrder(complaint) && slaNotices != nullptr) {
+        *slaNotices << "SLA: complaint ID " << complaintId << " unreplied for over "
+             << slaStages[stage].hours << "h, escalated to urgent order "
+             << complaint.order << ".\n";
+    }
+    scheduleSlaTimer(complaint, stage);
+}
+
+// Advances the SLA wheel to the current time
+void runSlaTimers() {
+    slaWheel.advance(TimerWheel::tickOf(time(nullptr)), escalateComplaint);
+}
+
+// Rebuilds the wheel from the open complaints; used at startup and whenever
+// the thresholds change
+void rescheduleSlaTimers() {
+    slaWheel.reset(TimerWheel::tickOf(time(nullptr)));
+    for (const Complaint& complaint : complaintQueue) {
+        scheduleSlaTimer(complaint, -1);
+    }
+    runSlaTimers();
+}
+
+string formatTime(time_t t) {
+    if (t == 0) return "Unknown";
+    char buffer[32];
+    strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M", localtime(&t));
+    return buffer;
+}
+
+string formatAge(time_t seconds) {
+    return to_string(seconds / 3600) + "h " + to_string(seconds % 3600 / 60) + "m";
+}
+
+void showSlaReport(ostream& out = cout) {
+    time_t now = time(nullptr);
+    vector<time_t> ages;
+    int unknown = 0;
+    for (const Complaint& complaint : complaintQueue) {
+        if (!complaint.replied) {
+            if (complaint.createdAt == 0) {
+                unknown++;
+            } else {
+                ages.push_back(now - complaint.createdAt);
+            }
+        }
+    }
+
+    out << "=========================================\n";
+    out << "SLA Report\n";
+    out << "Open complaints: " << ages.size() + unknown << "\n";
+    if (unknown > 0) {
+        out << "Without creation time: " << unknown << "\n";
+    }
+    if (!ages.empty()) {
+        sort(ages.begin(), ages.end());
+        auto percentile = [&](size_t p) { return ages[(ages.size() * p + 99) / 100 - 1]; }; // Nearest rank
+        out << "Age p50: " << formatAge(percentile(50)) << "\n";
+        out << "Age p90: " << formatAge(percentile(90)) << "\n";
+        out << "Age p99: " << formatAge(percentile(99)) << "\n";
+        out << "Oldest: " << formatAge(ages.back()) << "\n";
+        for (int stage = 0; stage < SLA_STAGE_COUNT; stage++) {
+            time_t threshold = (time_t)slaStages[stage].hours * 3600;
+            long over = ages.end() - lower_bound(ages.begin(), ages.end(), threshold);
+            out << "Over " << slaStages[stage].hours << "h: " << over << "\n";
+        }
+    }
+    out << "Pending SLA timers: " << slaWheel.getPending() << "\n";
+    out << "=========================================\n";
+}
+
+void editSlaSettings() {
+    cout << "Current SLA stages:\n";
+    for (int stage = 0; stage < SLA_STAGE_COUNT; stage++) {
+        cout << stage + 1 << ") After " << slaStages[stage].hours << "h -> urgent order "
+             << slaStages[stage].order << "\n";
+    }
+    SlaStage updated[SLA_STAGE_COUNT];
+    for (int stage = 0; stage < SLA_STAGE_COUNT; stage++) {
+        cout << "Stage " << stage + 1 << " age in hours: ";
+        cin >> updated[stage].hours;
+        cout << "Stage " << stage + 1 << " priority order: ";
+        cin >> updated[stage].order;
+        if (cin.fail()) {
+            handleInvalidInput();
+            return;
+        }
+        if (updated[stage].hours <= 0 || (stage > 0 && updated[stage].hours <= updated[stage - 1].hours)) {
+            cout << "Stage ages must be positive and increasing.\n";
+            return;
+        }
+        if (updated[stage].order < MIN_URGENT_ORDER) {
+            cout << URGENT_ORDER_ERROR << "\n";
+            return;
+        }
+    }
+    for (int stage = 0; stage < SLA_STAGE_COUNT; stage++) {
+        slaStages[stage] = updated[stage];
+    }
+    rescheduleSlaTimers();
+    cout << "SLA settings updated.\n";
+}
+
+// Admission control settings: every email address and phone number gets a
+// token bucket holding up to ADMISSION_BURST submissions that refills at
+// ADMISSION_REFILL_PER_HOUR
+const float ADMISSION_BURST = 5;
+const float ADMISSION_REFILL_PER_HOUR = 10;
+const int ADMISSION_TABLE_BITS = 16; // 65536 buckets
+const int ADMISSION_PROBE_LIMIT = 8; // Slots searched before a bucket is reused
+const size_t ADMISSION_MAX_MERGED_BYTES = 8 * 1024; // Stored content a complaint may grow to by merging
+
+// Token buckets in a fixed-size open-addressed table of 16-byte slots. The
+// low bits of a 64-bit hash of the customer key pick the slot and the high
+// 32 bits are kept as its fingerprint; customers whose fingerprints collide
+// in the same window share a bucket, which is rare enough not to matter.
+// Buckets refill lazily when they are looked up. When a
+// key's probe window is full the bucket with the most tokens is reused: a
+// full bucket is the same as a fresh one, so memory stays bounded however
+// many distinct customers write in.
+class AdmissionTable {
+public:
+    struct Bucket {
+        uint32_t fingerprint; // 0 when the slot is empty
+        float tokens;
+        uint32_t refilledAt; // Seconds since the epoch
+        int lastComplaintId; // Latest complaint admitted for this key, 0 if none
+    };
+
+private:
+    vector<Bucket> buckets;
+    size_t used;
+    long evictions;
+
+    void refill(Bucket& bucket, uint32_t now) const {
+        if (now > bucket.refilledAt) {
+            bucket.tokens = min(ADMISSION_BURST,
+                                bucket.tokens + (now - bucket.refilledAt) * (ADMISSION_REFILL_PER_HOUR / 3600));
+            bucket.refilledAt = now;
+        }
+    }
+
+public:
+    AdmissionTable() : buckets((size_t)1 << ADMISSION_TABLE_BITS, Bucket{0, 0, 0, 0}), used(0), evictions(0) {}
+
+    // FNV-1a hash of a normalized customer key, computed without building
+    // the key: emails are lower-cased and phone numbers keep only their
+    // digits, so "010-1234" and "0101234" share a bucket. The kind byte
+    // keeps email and phone keys apart; returns 0 for a key with no
+    // characters left.
+    static uint64_t hashKey(char kind, const string& text) {
+        uint64_t hash = (14695981039346656037ULL ^ (unsigned char)kind) * 1099511628211ULL;
+        bool empty = true;
+        for (unsigned char c : text) {
+            if (kind == 'p' && (c < '0' || c > '9')) continue;
+            if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+            hash = (hash ^ c) * 1099511628211ULL;
+            empty = false;
+        }
+        return empty ? 0 : max(hash, (uint64_t)1);
+    }
+
+    // Finds or creates the bucket for a key hash, refilled up to now. keep
+    // is never reused, so two buckets can be held at once.
+    Bucket& lookup(uint64_t hash, uint32_t now, const Bucket* keep = nullptr) {
+        size_t mask = buckets.size() - 1;
+        uint32_t fingerprint = max((uint32_t)(hash >> 32), 1u);
+        Bucket* victim = nullptr;
+        for (int probe = 0; probe < ADMISSION_PROBE_LIMIT; probe++) {
+            Bucket& bucket = buckets[(hash + probe) & mask];
+            if (bucket.fingerprint == fingerprint) {
+                refill(bucket, now);
+                return bucket;
+            }
+            if (bucket.fingerprint == 0) { // Slots never empty again, so the key is not further on
+                used++;
+                bucket = Bucket{fingerprint, ADMISSION_BURST, now, 0};
+                return bucket;
+            }
+            if (&bucket == keep) continue;
+            refill(bucket, now);
+            if (victim == nullptr || bucket.tokens > victim->tokens) victim = &bucket;
+        }
+        evictions++;
+        *victim = Bucket{fingerprint, ADMISSION_BURST, now, 0};
+        return *victim;
+    }
+
+    size_t getUsed() const { return used; }
+    size_t getCapacity() const { return buckets.size(); }
+    size_t memoryBytes() const { return buckets.size() * sizeof(Bucket); }
+    long getEvictions() const { return evictions; }
+};
+
+AdmissionTable admissionTable;
+
+// Outcome of a submission under admission control
+enum class Admission { ACCEPTED, MERGED, REJECTED };
+
+struct AdmissionStats {
+    long accepted;
+    long merged;
+    long rejected;
+    long long checkNanos; // Time spent in admission checks
+    AdmissionStats() : accepted(0), merged(0), rejected(0), checkNanos(0) {}
+};
+
+AdmissionStats admissionStats;
+
+// Buckets charged for one submission; byPhone is null without a phone number
+struct AdmissionCheck {
+    AdmissionTable::Bucket* byEmail;
+    AdmissionTable::Bucket* byPhone;
+    bool admitted;
+};
+
+// Takes a token from both of the customer's buckets if both have one
+AdmissionCheck chargeAdmission(const string& email, const string& phone, uint32_t now) {
+    AdmissionCheck check;
+    check.byEmail = &admissionTable.lookup(AdmissionTable::hashKey('e', email), now);
+    uint64_t phoneKey = AdmissionTable::hashKey('p', phone);
+    check.byPhone = phoneKey == 0 ? nullptr : &admissionTable.lookup(phoneKey, now, check.byEmail);
+    check.admitted = check.byEmail->tokens >= 1 && (check.byPhone == nullptr || check.byPhone->tokens >= 1);
+    if (check.admitted) {
+        check.byEmail->tokens -= 1;
+        if (check.byPhone != nullptr) check.byPhone->tokens -= 1;
+    }
+    return check;
+}
+
+void showAdmissionStats(ostream& out = cout) {
+    long submissions = admissionStats.accepted + admissionStats.merged + admissionStats.rejected;
+    out << "=========================================\n";
+    out << "Admission Control\n";
+    out << "Limit per email and phone: " << ADMISSION_BURST << " at once, "
+        << ADMISSION_REFILL_PER_HOUR << " per hour\n";
+    out << "Accepted: " << admissionStats.accepted << ", merged: " << admissionStats.merged
+        << ", rejected: " << admissionStats.rejected << "\n";
+    out << "Buckets: " << admissionTable.getUsed() << "/" << admissionTable.getCapacity() << " ("
+        << admissionTable.memoryBytes() / 1024 << " KB), reused: " << admissionTable.getEvictions() << "\n";
+    if (submissions > 0) {
+        out << "Limiter overhead: " << admissionStats.checkNanos / submissions << " ns per submission\n";
+    }
+    out << "=========================================\n";
+}
+
+// Appends a submission that arrived over the limit to an open complaint
+void appendFollowUp(Complaint& complaint, const string& content) {
+    complaint.content = complaint.content.str() + " | Follow-up: " + content;
+}
+
+// Store operations shared by the console menus and the network server. They
+// keep every index (ID index, SLA wheel, filter bitmaps) in step with the store.
+
+bool isValidEmail(const string& email) {
+    return !email.empty() && email.find('@') != string::npos;
+}
+
+Complaint* mergeIntoComplaint(int complaintId, const string& content) {
+    Complaint* complaint = findComplaint(complaintId, true);
+    if (complaint == nullptr) return nullptr;
+    appendFollowUp(*complaint, content);
+    changeLog.record("MERGE", to_string(complaintId) + '|' + escapeField(content));
+    return complaint;
+}
+
+// Whether the complaint was filed under this email or phone, compared the
+// way the admission table keys them
+bool filedBy(const Complaint& complaint, const string& email, const string& phone) {
+    uint64_t phoneKey = AdmissionTable::hashKey('p', phone);
+    return AdmissionTable::hashKey('e', complaint.customer.getEmail()) == AdmissionTable::hashKey('e', email)
+           || (phoneKey != 0 && AdmissionTable::hashKey('p', complaint.customer.getPhone()) == phoneKey);
+}
+
+// Files a new complaint if the customer's email and phone buckets both have
+// a token. Otherwise the text is merged into the customer's latest open
+// complaint, or rejected if there is none or it has already grown to
+// ADMISSION_MAX_MERGED_BYTES. Returns the complaint that holds the text, or
+// nullptr when rejected.
+Complaint* submitComplaint(const string& name, const string& phone, const string& email, const string& content,
+                           Admission& admission) {
+    auto start = chrono::steady_clock::now();
+    AdmissionCheck check = chargeAdmission(email, phone, (uint32_t)time(nullptr));
+    int mergeId = 0;
+    if (check.admitted) {
+        admission = Admission::ACCEPTED;
+    } else {
+        admission = Admission::REJECTED;
+        int byPhoneId = check.byPhone == nullptr ? 0 : check.byPhone->lastComplaintId;
+        for (int candidate : {check.byEmail->lastComplaintId, byPhoneId}) {
+            Complaint* open = candidate > mergeId ? findComplaint(candidate) : nullptr;
+            // An import may have reused the ID of the customer's deleted complaint
+            if (open != nullptr && filedBy(*open, email, phone) && !open->replied
+                && open->content.storedSize() + content.size() <= ADMISSION_MAX_MERGED_BYTES) {
+                mergeId = candidate;
+                admission = Admission::MERGED;
+            }
+        }
+    }
+    admissionStats.checkNanos +=
+        chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+
+    if (admission == Admission::REJECTED) {
+        admissionStats.rejected++;
+        return nullptr;
+    }
+    if (admission == Admission::MERGED) {
+        admissionStats.merged++;
+        return mergeIntoComplaint(mergeId, content);
+    }
+    admissionStats.accepted++;
+    Complaint* stored = emplaceComplaint(content, false, false, Customer(name, phone, email));
+    check.byEmail->lastComplaintId = stored->id;
+    if (check.byPhone != nullptr) check.byPhone->lastComplaintId = stored->id;
+    scheduleSlaTimer(*stored, -1);
+    filterIndex.update(*stored);
+    changeLog.record("ADD", encodeComplaint(*stored));
+    return stored;
+}
+
+// Deletes a complaint from whichever tier holds it
+bool removeComplaint(int complaintId) {
+    Complaint* complaint = findComplaint(complaintId);
+    if (complaint == nullptr) return false;
+    filterIndex.remove(*complaint);
+    ComplaintQueue::Node* node = complaintIndex.find(complaintId);
+    if (node != nullptr) {
+        removeHotComplaint(node);
+    } else if (!coldStore.remove(complaintId)) {
+        return false;
+    }
+    changeLog.record("DELETE", to_string(complaintId));
+    return true;
+}
+
+// Returns the updated complaint, or nullptr if it does not exist
+Complaint* replyToComplaint(int complaintId, const string& reply) {
+    Complaint* complaint = findComplaint(complaintId, true);
+    if (complaint == nullptr) return nullptr;
+    complaint->addReply(reply);
+    filterIndex.update(*complaint);
+    changeLog.record("REPLY", to_string(complaintId) + '|' + to_string((long long)complaint->repliedAt) + '|'
+                              + escapeField(reply));
+    return complaint;
+}
+
+Complaint* summarizeComplaint(int complaintId, const string& employeeId, const string& summary) {
+    Complaint* complaint = findComplaint(complaintId, true);
+    if (complaint == nullptr) return nullptr;
+    complaint->addReply(summary); // Treat summary as reply
+    complaint->summarizedBy = employeeId;
+    filterIndex.update(*complaint);
+    summaryStack.push(*complaint);
+    changeLog.record("SUMMARY", to_string(complaintId) + '|' + to_string((long long)complaint->repliedAt) + '|'
+                                + escapeField(employeeId) + '|' + escapeField(summary));
+    return complaint;
+}
+
+Complaint* markComplaintUrgent(int complaintId, int order) {
+    Complaint* complaint = promoteComplaint(complaintId); // Urgent complaints stay hot
+    if (complaint == nullptr) return nullptr;
+    complaint->urgent = true;
+    complaint->order = order;
+    filterIndex.update(*complaint);
+    requeueUrgent(*complaint);
+    changeLog.record("URGENT", to_string(complaintId) + '|' + to_string(order));
+    return complaint;
+}
+
+void writeComplaintDetails(ostream& out, const Complaint& complaint) {
+    out << "=========================================\n";
+    out << "Complaint Details\n";
+    out << "ID: " << complaint.id << "\n";
+    out << "Customer Name: " << complaint.customer.getName() << "\n";
+    out << "Customer Email: " << complaint.customer.getEmail() << "\n";
+    out << "Content: " << complaint.content << "\n";
+    out << "Replied: " << (complaint.replied ? "Yes" : "No") << "\n";
+    if (complaint.replied) {
+        out << "Reply Details: " << complaint.replyDetails << "\n";
+    }
+    out << "Urgent: " << (complaint.urgent ? "Yes" : "No") << "\n";
+    out << "Created: " << formatTime(complaint.createdAt) << "\n";
+    if (complaint.replied) {
+        out << "Replied At: " << formatTime(complaint.repliedAt) << "\n";
+    }
+    out << "=========================================\n";
+}
+
+// Writes the complaint if it was filed under email; returns whether it was
+bool writeHistoryEntry(ostream& out, const Complaint& complaint, const string& email) {
+    if (complaint.customer.getEmail() != email) return false;
+    out << "=========================================\n";
+    out << "Complaint ID: " << complaint.id << "\n";
+    out << "Customer Name: " << complaint.customer.getName() << "\n";
+    out << "Content: " << complaint.content << "\n";
+    out << "Replied: " << (complaint.replied ? "Yes" : "No") << "\n";
+    if (complaint.replied) {
+        out << "Reply Details: " << complaint.replyDetails << "\n";
+    }
+    out << "=========================================\n";
+    return true;
+}
+
+// Writes every complaint filed under email; returns how many matched
+int writeHistory(ostream& out, const string& email) {
+    int found = 0;
+    auto showMatch = [&](const Complaint& complaint) {
+        if (writeHistoryEntry(out, complaint, email)) found++;
+    };
+    coldStore.forEach(showMatch);
+    for (const Complaint& complaint : complaintQueue) {
+        showMatch(complaint);
+    }
+    return found;
+}
+
+void writeUnrepliedComplaints(ostream& out) {
+    int count = 0;
+    out << "=========================================\n";
+    out << "Unreplied Complaints\n";
+    for (const Complaint& complaint : complaintQueue) {
+        if (!complaint.replied) {
+            count++;
+            out << "ID: " << complaint.id << "\n";
+            out << "Customer Name: " << complaint.customer.getName() << "\n";
+            out << "Content: " << complaint.content << "\n";
+            out << "Urgent: " << (complaint.urgent ? "Yes" : "No") << "\n";
+            out << "-----------------------------------------\n";
+        }
+    }
+    out << "Total unreplied: " << count << "\n";
+    out << "=========================================\n";
+}
+
+// Writes summarized complaints whose content contains text ("" for all)
+void writeSummaries(ostream& out, const string& text) {
+    if (summaryStack.isEmpty()) {
+        out << "No summaries found.\n";
+        return;
+    }
+    out << "=========================================\n";
+    out << (text.empty() ? "Complaints with Summaries\n" : "Search Results\n");
+    for (const Complaint& complaint : summaryStack) {
+        if (text.empty() || complaint.content.str().find(text) != string::npos) {
+            out << "ID: " << complaint.id << "\n";
+            out << "Content: " << complaint.content << "\n";
+            out << "Summary: " << complaint.replyDetails << "\n";
+            out << "-----------------------------------------\n";
+        }
+    }
+    out << "=========================================\n";
+}
+
+void writeEmployees(ostream& out) {
+    if (empList.isEmpty()) {
+        out << "No employees found.\n";
+        return;
+    }
+    out << "Employees List\n================\n";
+    for (const Employee& employee : empList) {
+        out << "Name: " << employee.getName() << "\n";
+        out << "ID: " << employee.getId() << "\n";
+        out << "Password: " << employee.getPassword() << "\n";
+        out << "---------------\n";
+    }
+    out << "================\n";
+}
+
+bool removeEmployee(const string& id) {
+    return empList.removeIf([&](const Employee& employee) { return employee.getId() == id; });
+}
+
+int totalComplaintCount() {
+    return complaintQueue.getSize() + coldStore.getCount();
+}
+
+// Replays one change log entry recorded by a primary. Entries keep the
+// primary's IDs and timestamps, so replicas converge on the same state.
+bool applyChange(const string& op, const string& fields) {
+    vector<string> parts = splitEscapedFields(fields);
+    int complaintId = atoi(parts[0].c_str());
+    if (op == "ADD") {
+        Complaint complaint;
+        if (!decodeComplaint(fields, complaint)) return false;
+        if (complaint.id > Complaint::lastId) Complaint::lastId = complaint.id;
+        Complaint* stored = emplaceComplaint(move(complaint));
+        restoreUrgent(*stored);
+        filterIndex.update(*stored);
+        return true;
+    }
+    if (op == "DELETE") {
+        Complaint* complaint = findComplaint(complaintId);
+        if (complaint == nullptr) return false;
+        filterIndex.remove(*complaint);
+        ComplaintQueue::Node* node = complaintIndex.find(complaintId);
+        if (node != nullptr) {
+            removeHotComplaint(node);
+            return true;
+        }
+        return coldStore.remove(complaintId);
+    }
+    bool toUrgent = op == "URGENT" || op == "ESCALATE";
+    Complaint* complaint = toUrgent ? promoteComplaint(complaintId) : findComplaint(complaintId, true);
+    if (complaint == nullptr) return false;
+    if ((op == "REPLY" && parts.size() == 3) || (op == "SUMMARY" && parts.size() == 4)) {
+        complaint->addReply(parts.back());
+        complaint->repliedAt = (time_t)atoll(parts[1].c_str());
+        if (op == "SUMMARY") {
+            complaint->summarizedBy = parts[2];
+            summaryStack.push(*complaint);
+        }
+    } else if (op == "MERGE" && parts.size() == 2) {
+        appendFollowUp(*complaint, parts[1]);
+    } else if (toUrgent && parts.size() == 2) {
+        complaint->urgent = true;
+        complaint->order = atoi(parts[1].c_str());
+        if (op == "URGENT") {
+            requeueUrgent(*complaint);
+        } else {
+            raiseUrgentOrder(*complaint);
+        }
+    } else {
+        return false;
+    }
+    filterIndex.update(*complaint);
+    return true;
+}
+
+// Customer functions
+void addNewComplaint() {
+    string name, phone, email, content;
+    cout << "Enter your name: ";
+    getline(cin >> ws, name);
+    cout << "Enter your phone number: ";
+    getline(cin, phone);
+    cout << "Enter your email: ";
+    getline(cin, email);
+    if (!isValidEmail(email)) {
+        cout << "Invalid email format!\n";
+        return;
+    }
+    cout << "Enter complaint content: ";
+    getline(cin, content);
     if (content.empty()) {
         cout << "Complaint content cannot be empty!\n";
         return;
     }
-
-    Customer customer(name, phone, email);
-    Complaint complaint(content, false, false, customer);
-    complaintQueue.enqueue(complaint);
-    cout << "Complaint ID: " << complaint.id << "\n";
-    cout << "Complaint received. We will respond soon.\n";
+
+    Admission admission;
+    Complaint* stored = submitComplaint(name, phone, email, content, admission);
+    if (admission == Admission::REJECTED) {
+        cout << "Too many complaints submitted recently. Please try again later.\n";
+        return;
+    }
+    cout << "Complaint ID: " << stored->id << "\n";
+    if (admission == Admission::MERGED) {
+        cout << "Too many complaints submitted recently; this was added to your open complaint.\n";
+        return;
+    }
+    cout << "Complaint received. We will respond soon.\n";
+}
+
+void deleteComplaint() {
+    int complaintId;
+    cout << "Enter complaint ID to delete: ";
+    cin >> complaintId;
+    if (cin.fail()) {
+        handleInvalidInput();
+        return;
+    }
+
+    if (removeComplaint(complaintId)) {
+        cout << "Complaint ID " << complaintId << " deleted successfully!\n";
+    } else {
+        cout << "Complaint ID " << complaintId << " not found!\n";
+    }
+}
+
+void showComplaintDetails() {
+    int complaintId;
+    cout << "Enter complaint ID: ";
+    cin >> complaintId;
+    if (cin.fail()) {
+        handleInvalidInput();
+        return;
+    }
+
+    Complaint* complaint = findComplaint(complaintId);
+    if (complaint == nullptr) {
+        cout << "Complaint ID " << complaintId << " not found.\n";
+        return;
+    }
+    writeComplaintDetails(cout, *complaint);
+}
+
+void searchHistory() {
+    string email;
+    cout << "Enter email to search complaints: ";
+    cin >> email;
+    if (totalComplaintCount() == 0) {
+        cout << "No complaints in queue.\n";
+        return;
+    }
+
+    if (writeHistory(cout, email) == 0) {
+        cout << "No complaints found for email: " << email << "\n";
+    }
+}
+
+// Employee functions
+void addReply() {
+    int complaintId;
+    cout << "Enter complaint ID to reply: ";
+    cin >> complaintId;
+    if (cin.fail()) {
+        handleInvalidInput();
+        return;
+    }
+
+    if (findComplaint(complaintId) == nullptr) {
+        cout << "Complaint ID " << complaintId << " not found.\n";
+        return;
+    }
+    string reply;
+    cout << "Enter reply details: ";
+    getline(cin >> ws, reply);
+    replyToComplaint(complaintId, reply);
+    cout << "Reply added successfully!\n";
+}
+
+void showUnrepliedComplaints(bool employeeMode = false) {
+    if (complaintQueue.isEmpty()) {
+        cout << "No complaints found.\n";
+        return;
+    }
+
+    writeUnrepliedComplaints(cout);
+
+    if (employeeMode) {
+        int option;
+        do {
+            cout << "1) Reply to Complaint\n2) Back\nOption: ";
+            cin >> option;
+            if (cin.fail()) {
+                handleInvalidInput();
+                continue;
+            }
+            if (option == 1) addReply();
+        } while (option != 2);
+    }
+}
+
+void addProblemSummary() {
+    int complaintId;
+    cout << "Enter complaint ID for summary: ";
+    cin >> complaintId;
+    if (cin.fail()) {
+        handleInvalidInput();
+        return;
+    }
+
+    if (findComplaint(complaintId) == nullptr) {
+        cout << "Complaint ID " << complaintId << " not found.\n";
+        return;
+    }
+    string employeeId, summary;
+    cout << "Enter your employee ID: ";
+    getline(cin >> ws, employeeId);
+    cout << "Enter problem summary: ";
+    getline(cin >> ws, summary);
+    summarizeComplaint(complaintId, employeeId, summary);
+    cout << "Summary added successfully!\n";
+}
+
+void showComplaintsWithSummary() {
+    writeSummaries(cout, "");
+}
+
+void searchByComplaintNameWithSummary() {
+    string name;
+    cout << "Enter complaint content to search: ";
+    getline(cin >> ws, name);
+    writeSummaries(cout, name);
+}
+
+// Admin functions
+void addNewEmployee() {
+    string name, id, password;
+    cout << "Enter employee name: ";
+    getline(cin >> ws, name);
+    cout << "Enter employee ID: ";
+    getline(cin, id);
+    cout << "Enter employee password: ";
+    getline(cin, password);
+    empList.emplaceFront(name, id, password);
+    cout << "Employee added successfully!\n";
+}
+
+void displayEmployees() {
+    writeEmployees(cout);
+}
+
+void deleteEmployee() {
+    string id;
+    cout << "Enter employee ID to delete: ";
+    cin >> id;
+    if (removeEmployee(id)) {
+        cout << "Employee ID " << id << " deleted successfully!\n";
+    } else {
+        cout << "Employee ID " << id << " not found.\n";
+    }
+}
+
+void addUrgentComplaint() {
+    int complaintId;
+    cout << "Enter complaint ID for urgent: ";
+    cin >> complaintId;
+    if (cin.fail()) {
+        handleInvalidInput();
+        return;
+    }
+
+    if (findComplaint(complaintId) == nullptr) {
+        cout << "Complaint ID " << complaintId << " not found.\n";
+        return;
+    }
+    int order;
+    cout << "Enter priority order (lower = higher priority): ";
+    cin >> order;
+    if (cin.fail()) {
+        handleInvalidInput();
+        return;
+    }
+    if (order < MIN_URGENT_ORDER) {
+        cout << URGENT_ORDER_ERROR << "\n";
+        return;
+    }
+    markComplaintUrgent(complaintId, order);
+    cout << "Complaint ID " << complaintId << " added to urgent queue.\n";
+}
+
+// Number of complaints shown per page when browsing by ID
+const size_t BROWSE_PAGE_SIZE = 10;
+
+// Merges hot (ID index) and cold (segment) complaints with IDs in [from, to]
+// into ID order, stopping after limit complaints
+vector<Complaint> collectComplaintRange(int from, int to, size_t limit) {
+    vector<Complaint> cold = coldStore.collectRange(from, to, limit);
+    vector<Complaint> result;
+    IdIndex::Cursor cursor = complaintIndex.seek(from);
+    size_t coldPos = 0;
+    while (result.size() < limit) {
+        bool hotLeft = cursor.valid() && cursor.key() <= to;
+        if (!hotLeft && coldPos == cold.size()) break;
+        if (hotLeft && (coldPos == cold.size() || cursor.key() < cold[coldPos].id)) {
+            result.push_back(cursor.value()->data);
+            cursor.next();
+        } else {
+            result.push_back(cold[coldPos++]);
+        }
+    }
+    return result;
+}
+
+void printComplaintRow(const Complaint& complaint, ostream& out = cout) {
+    out << "ID: " << complaint.id
+        << " | " << complaint.customer.getName()
+        << " | Replied: " << (complaint.replied ? "Yes" : "No")
+        << " | Urgent: " << (complaint.urgent ? "Yes" : "No")
+        << " | " << complaint.content << "\n";
+}
+
+void showComplaintRange() {
+    int from, to;
+    cout << "Enter first complaint ID: ";
+    cin >> from;
+    cout << "Enter last complaint ID: ";
+    cin >> to;
+    if (cin.fail()) {
+        handleInvalidInput();
+        return;
+    }
+
+    vector<Complaint> complaints = collectComplaintRange(from, to, numeric_limits<size_t>::max());
+    cout << "=========================================\n";
+    for (const Complaint& complaint : complaints) {
+        printComplaintRow(complaint);
+    }
+    cout << "Complaints in range: " << complaints.size() << "\n";
+    cout << "=========================================\n";
+}
+
+void browseComplaints() {
+    int nextId;
+    cout << "Enter complaint ID to start from: ";
+    cin >> nextId;
+    if (cin.fail()) {
+        handleInvalidInput();
+        return;
+    }
+
+    int option = 1;
+    while (option == 1) {
+        vector<Complaint> page = collectComplaintRange(nextId, numeric_limits<int>::max(), BROWSE_PAGE_SIZE);
+        cout << "=========================================\n";
+        for (const Complaint& complaint : page) {
+            printComplaintRow(complaint);
+        }
+        cout << "=========================================\n";
+        if (page.size() < BROWSE_PAGE_SIZE || page.back().id == numeric_limits<int>::max()) {
+            cout << "End of complaints.\n";
+            return;
+        }
+        nextId = page.back().id + 1;
+        cout << "1) Next Page\n0) Back\nOption: ";
+        cin >> option;
+        if (cin.fail()) {
+            handleInvalidInput();
+            return;
+        }
+    }
+}
+
+// Number of matching IDs printed per line when listing filter results
+const int FILTER_IDS_PER_LINE = 10;
+
+// Builds the filter index on first use
+void ensureFilterIndex() {
+    if (filterIndex.isBuilt()) return;
+    cout << "Building filter index...\n";
+    filterIndex.build([](auto visit) {
+        coldStore.forEach(visit);
+        for (const Complaint& complaint : complaintQueue) {
+            visit(complaint);
+        }
+    });
+}
+
+void filterComplaints() {
+    ensureFilterIndex();
+
+    string expression;
+    cout << "Terms: all, replied, unreplied, urgent, summarized, domain=<domain>\n";
+    cout << "Operators: NOT, AND, OR, ( )\n";
+    cout << "Enter filter: ";
+    getline(cin >> ws, expression);
+
+    auto start = chrono::steady_clock::now();
+    RoaringBitmap result;
+    string error;
+    if (!FilterQuery(filterIndex).evaluate(expression, result, error)) {
+        cout << error << "\n";
+        return;
+    }
+    long micros = (long)chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    cout << "Matching complaints: " << result.cardinality() << " (" << micros << " us)\n";
+    cout << "Index: " << filterIndex.allIds().cardinality() << " complaints, "
+         << filterIndex.getDomainCount() << " domains, " << filterIndex.memoryBytes() / 1024 << " KB\n";
+
+    int option;
+    cout << "1) List IDs\n0) Back\nOption: ";
+    cin >> option;
+    if (cin.fail()) {
+        handleInvalidInput();
+        return;
+    }
+    if (option != 1) return;
+    int column = 0;
+    result.forEach([&](uint32_t id) {
+        cout << id << (++column % FILTER_IDS_PER_LINE == 0 ? "\n" : " ");
+    });
+    if (column % FILTER_IDS_PER_LINE != 0) cout << "\n";
+}
+
+// Urgent backlog bands by urgent queue order (upper bound of each band)
+const int PRIORITY_BAND_COUNT = 4;
+const int PRIORITY_BAND_LIMITS[PRIORITY_BAND_COUNT] = {1, 3, 10, numeric_limits<int>::max()};
+const char* const PRIORITY_BAND_NAMES[PRIORITY_BAND_COUNT] = {"Order 1", "Order 2-3", "Order 4-10", "Order 11+"};
+
+// Hot complaints handed to one report task at a time
+const size_t REPORT_CHUNK_SIZE = 1 << 16;
+
+// Admin report aggregates. Every worker thread fills its own partial report
+// and the partials are merged once all tasks are done.
+struct ComplaintReport {
+    long total;
+    long replied;
+    long urgentOpen;
+    long unknownTime; // Complaints without a creation time (hourly intake)
+    long priorityBands[PRIORITY_BAND_COUNT];
+    long hourlyIntake[24];
+    unordered_map<string, long> domains;
+    unordered_map<string, long> summariesByEmployee;
+
+    ComplaintReport() : total(0), replied(0), urgentOpen(0), unknownTime(0) {
+        fill(priorityBands, priorityBands + PRIORITY_BAND_COUNT, 0);
+        fill(hourlyIntake, hourlyIntake + 24, 0);
+    }
+
+    // utcOffset is the local time zone offset in seconds, for hourly buckets
+    void add(const Complaint& complaint, long utcOffset) {
+        total++;
+        if (complaint.replied) replied++;
+        if (complaint.urgent && !complaint.replied) {
+            urgentOpen++;
+            int band = 0;
+            int order = max(complaint.order, MIN_URGENT_ORDER); // As restoreUrgent queues it
+            while (order > PRIORITY_BAND_LIMITS[band]) band++;
+            priorityBands[band]++;
+        }
+        domains[emailDomain(complaint.customer.getEmail())]++;
+        if (!complaint.summarizedBy.empty()) summariesByEmployee[complaint.summarizedBy]++;
+        if (complaint.createdAt == 0) {
+            unknownTime++;
+        } else {
+            long local = ((long)complaint.createdAt + utcOffset) % 86400;
+            hourlyIntake[(local + 86400) % 86400 / 3600]++;
+        }
+    }
+
+    void merge(const ComplaintReport& other) {
+        total += other.total;
+        replied += other.replied;
+        urgentOpen += other.urgentOpen;
+        unknownTime += other.unknownTime;
+        for (int band = 0; band < PRIORITY_BAND_COUNT; band++) priorityBands[band] += other.priorityBands[band];
+        for (int hour = 0; hour < 24; hour++) hourlyIntake[hour] += other.hourlyIntake[hour];
+        for (const auto& entry : other.domains) domains[entry.first] += entry.second;
+        for (const auto& entry : other.summariesByEmployee) summariesByEmployee[entry.first] += entry.second;
+    }
+
+    static void printCounts(ostream& out, const unordered_map<string, long>& counts) {
+        vector<pair<long, string>> sorted;
+        for (const auto& entry : counts) sorted.push_back({entry.second, entry.first});
+        sort(sorted.begin(), sorted.end(), [](const pair<long, string>& a, const pair<long, string>& b) {
+            return a.first != b.first ? a.first > b.first : a.second < b.second;
+        });
+        if (sorted.empty()) out << "  (none)\n";
+        for (const auto& entry : sorted) out << "  " << entry.second << ": " << entry.first << "\n";
+    }
+
+    void print(ostream& out) const {
+        ios::fmtflags flags = out.flags();
+        streamsize precision = out.precision();
+        out << "=========================================\n";
+        out << "Complaint Report\n";
+        out << "Total complaints: " << total << "\n";
+        out << "Replied: " << replied;
+        if (total > 0) out << " (" << fixed << setprecision(1) << 100.0 * replied / total << "%)";
+        out << "\n";
+        out << "Open urgent backlog: " << urgentOpen << "\n";
+        for (int band = 0; band < PRIORITY_BAND_COUNT; band++) {
+            out << "  " << PRIORITY_BAND_NAMES[band] << ": " << priorityBands[band] << "\n";
+        }
+        out << "Complaints per email domain:\n";
+        printCounts(out, domains);
+        out << "Summaries per employee:\n";
+        printCounts(out, summariesByEmployee);
+        out << "Hourly intake:\n";
+        for (int hour = 0; hour < 24; hour++) {
+            out << "  " << setw(2) << setfill('0') << hour << ":00  " << setfill(' ') << hourlyIntake[hour] << "\n";
+        }
+        if (unknownTime > 0) out << "  Unknown time: " << unknownTime << "\n";
+        out << "=========================================\n";
+        out.flags(flags);
+        out.precision(precision);
+    }
+};
+
+// Seconds to add to a UTC timestamp to get local time
+long localUtcOffset() {
+    time_t now = time(nullptr);
+    tm local = *localtime(&now);
+    tm utc = *gmtime(&now);
+    utc.tm_isdst = local.tm_isdst;
+    return (long)(now - mktime(&utc));
+}
+
+// Builds the report in parallel: tasks are chunks of hot complaints and whole
+// cold segment files, pulled by worker threads from a shared counter
+ComplaintReport buildComplaintReport(const vector<const Complaint*>& hot, const vector<string>& segmentFiles,
+                                     unsigned threadCount) {
+    long utcOffset = localUtcOffset();
+    size_t hotTasks = (hot.size() + REPORT_CHUNK_SIZE - 1) / REPORT_CHUNK_SIZE;
+    size_t taskCount = hotTasks + segmentFiles.size();
+    threadCount = max(1u, min(threadCount, (unsigned)max<size_t>(taskCount, 1)));
+    vector<ComplaintReport> partials(threadCount);
+    atomic<size_t> nextTask(0);
+
+    auto worker = [&](unsigned index) {
+        ComplaintReport& partial = partials[index];
+        for (size_t task = nextTask++; task < taskCount; task = nextTask++) {
+            if (task < hotTasks) {
+                size_t end = min(hot.size(), (task + 1) * REPORT_CHUNK_SIZE);
+                for (size_t i = task * REPORT_CHUNK_SIZE; i < end; i++) {
+                    partial.add(*hot[i], utcOffset);
+                }
+            } else {
+                ifstream inFile(segmentFiles[task - hotTasks]);
+                int version = readDataFileHeader(inFile);
+                Complaint complaint;
+                while (readComplaintRecord(inFile, complaint, version)) {
+                    partial.add(complaint, utcOffset);
+                }
+            }
+        }
+    };
+
+    vector<thread> workers;
+    for (unsigned i = 1; i < threadCount; i++) workers.emplace_back(worker, i);
+    worker(0);
+    for (thread& t : workers) t.join();
+
+    ComplaintReport report;
+    for (const ComplaintReport& partial : partials) report.merge(partial);
+    return report;
+}
+
+unsigned reportThreadCount() {
+    return max(1u, thread::hardware_concurrency());
+}
+
+void showReports() {
+    auto start = chrono::steady_clock::now();
+    vector<const Complaint*> hot;
+    hot.reserve(complaintQueue.getSize());
+    for (const Complaint& complaint : complaintQueue) {
+        hot.push_back(&complaint);
+    }
+    unsigned threads = reportThreadCount();
+    vector<string> segmentFiles = coldStore.getSegmentFiles(hot);
+    ComplaintReport report = buildComplaintReport(hot, segmentFiles, threads);
+    long ms = (long)chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+    report.print(cout);
+    cout << "Built in " << ms << " ms using " << threads << " thread(s).\n";
+
+    int option;
+    cout << "1) Export to File\n0) Back\nOption: ";
+    cin >> option;
+    if (cin.fail()) {
+        handleInvalidInput();
+        return;
+    }
+    if (option != 1) return;
+    string fileName;
+    cout << "Enter export file name: ";
+    getline(cin >> ws, fileName);
+    ofstream outFile(fileName);
+    if (!outFile.is_open()) {
+        cout << "Error: Unable to open file for writing!\n";
+        return;
+    }
+    report.print(outFile);
+    cout << "Report exported to " << fileName << "\n";
+}
+
+// --bench-reports [count]: times the report engine over synthetic complaints
+void runReportBenchmark(long count) {
+    cout << "Generating " << count << " synthetic complaints...\n";
+    const char* const domains[] = {"gmail.com", "yahoo.com", "outlook.com", "aast.edu", "example.org"};
+    vector<Complaint> complaints(count);
+    time_t base = time(nullptr) - 30L * 86400;
+    for (long i = 0; i < count; i++) {
+        Complaint& complaint = complaints[i];
+        complaint.id = (int)(i + 1);
+        complaint.customer = Customer("c" + to_string(i % 1000), "555",
+                                      "u" + to_string(i % 97) + "@" + domains[i % 5]);
+        complaint.replied = i % 3 != 0;
+        complaint.urgent = i % 7 == 0;
+        complaint.order = complaint.urgent ? (int)(i % 13) + 1 : 0;
+        complaint.createdAt = base + (time_t)(i * 7919 % (30L * 86400));
+        if (i % 11 == 0) complaint.summarizedBy = "E" + to_string(i % 20);
+    }
+    vector<const Complaint*> hot;
+    hot.reserve(count);
+    for (const Complaint& complaint : complaints) hot.push_back(&complaint);
+
+    vector<unsigned> threadCounts = {1};
+    if (reportThreadCount() > 1) threadCounts.push_back(reportThreadCount());
+    for (unsigned threads : threadCounts) {
+        auto start = chrono::steady_clock::now();
+        ComplaintReport report = buildComplaintReport(hot, {}, threads);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << threads << " thread(s): " << fixed << setprecision(3) << seconds << " s, "
+             << setprecision(1) << report.total / seconds / 1e6 << "M complaints/s\n";
+    }
+}
+
+// Node allocations made through any CountingAllocator, for --bench-containers
+long benchAllocations = 0;
+
+template <typename T>
+struct CountingAllocator {
+    typedef T value_type;
+
+    CountingAllocator() {}
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        benchAllocations++;
+        return allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) { allocator<T>().deallocate(p, n); }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const CountingAllocator<U>&) const { return false; }
+};
+
+// Complaint that counts its copies and moves, for --bench-containers
+struct TrackedComplaint : Complaint {
+    static long copies;
+    static long moves;
+
+    TrackedComplaint(const string& content, const Customer& customer, int urgentOrder)
+        : Complaint(content, false, false, customer) {
+        order = urgentOrder;
+    }
+    TrackedComplaint(const TrackedComplaint& other) : Complaint(other) { copies++; }
+    TrackedComplaint(TrackedComplaint&& other) : Complaint(move(other)) { moves++; }
+};
+long TrackedComplaint::copies = 0;
+long TrackedComplaint::moves = 0;
+
+template <typename Insert>
+void benchContainerInsert(const string& label, long count, Insert insert) {
+    benchAllocations = 0;
+    TrackedComplaint::copies = 0;
+    TrackedComplaint::moves = 0;
+    auto start = chrono::steady_clock::now();
+    for (long i = 0; i < count; i++) insert(i);
+    double nanos = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+    cout << left << setw(34) << label << right << fixed << setprecision(2)
+         << setw(8) << (double)benchAllocations / count
+         << setw(8) << (double)TrackedComplaint::copies / count
+         << setw(8) << (double)TrackedComplaint::moves / count
+         << setw(10) << setprecision(1) << nanos / count << "\n";
+}
+
+// --bench-containers [count]: node allocations, element copies and moves per
+// insertion, comparing copy-insertion of a temporary (how every container
+// was filled before) with in-place emplace
+void runContainerBenchmark(long count) {
+    typedef CountingAllocator<TrackedComplaint> Alloc;
+    const Customer customer("Benchmark Customer", "01000000000", "benchmark.customer@example.com");
+    const string content = "The order arrived damaged and nobody has answered my emails yet";
+    cout << count << " insertions per row\n";
+    cout << left << setw(34) << "Operation" << right << setw(8) << "allocs" << setw(8) << "copies"
+         << setw(8) << "moves" << setw(10) << "ns/op" << "\n";
+    {
+        LinkedQueue<TrackedComplaint, Alloc> queue;
+        benchContainerInsert("LinkedQueue enqueue(copy)", count, [&](long) {
+            TrackedComplaint complaint(content, customer, 0);
+            queue.enqueue(complaint);
+        });
+    }
+    {
+        LinkedQueue<TrackedComplaint, Alloc> queue;
+        benchContainerInsert("LinkedQueue emplace", count, [&](long) { queue.emplace(content, customer, 0); });
+    }
+    {
+        Stack<TrackedComplaint, Alloc> stack;
+        benchContainerInsert("Stack push(copy)", count, [&](long) {
+            TrackedComplaint complaint(content, customer, 0);
+            stack.push(complaint);
+        });
+    }
+    {
+        Stack<TrackedComplaint, Alloc> stack;
+        benchContainerInsert("Stack emplace", count, [&](long) { stack.emplace(content, customer, 0); });
+    }
+    // Decreasing orders keep every insertion at the head of the sorted list
+    {
+        PriorityQueue<TrackedComplaint, ByUrgentOrder, Alloc> queue;
+        benchContainerInsert("PriorityQueue insert(copy)", count, [&](long i) {
+            TrackedComplaint complaint(content, customer, (int)(count - i));
+            queue.insert(complaint);
+        });
+    }
+    {
+        PriorityQueue<TrackedComplaint, ByUrgentOrder, Alloc> queue;
+        benchContainerInsert("PriorityQueue emplace", count,
+                             [&](long i) { queue.emplace(content, customer, (int)(count - i)); });
+    }
+    {
+        LinkedList<TrackedComplaint, Alloc> list;
+        benchContainerInsert("LinkedList pushFront(copy)", count, [&](long) {
+            TrackedComplaint complaint(content, customer, 0);
+            list.pushFront(complaint);
+        });
+    }
+    {
+        LinkedList<TrackedComplaint, Alloc> list;
+        benchContainerInsert("LinkedList emplaceFront", count,
+                             [&](long) { list.emplaceFront(content, customer, 0); });
+    }
+}
+
+// Checks IdIndex cursors against std::set while keys are deleted under
+// them, including the key a cursor is at; returns the number of mismatches
+long runIndexCheck(long count) {
+    IdIndex index;
+    set<int> expected;
+    IdIndex::Value marker = reinterpret_cast<IdIndex::Value>(&index); // Any non-null value
+    for (int key = 1; key <= count; key++) {
+        index.insert(key, marker);
+        expected.insert(key);
+    }
+    mt19937 random(42);
+    long mismatches = 0, steps = 0;
+
+    // Keys 1..10: seek(1), erase(1), next() must land on 2
+    IdIndex::Cursor cursor = index.seek(1);
+    index.erase(1);
+    expected.erase(1);
+    if (!cursor.valid() || cursor.key() != 2) mismatches++;
+
+    // Walk the index, deleting the current key, a later key or nothing
+    // before every step
+    cursor = index.seek(0);
+    auto next = expected.begin();
+    while (cursor.valid()) {
+        if (next == expected.end() || cursor.key() != *next) {
+            mismatches++;
+            break;
+        }
+        int current = *next;
+        int later = current + 1 + (int)(random() % 8);
+        switch (random() % 3) {
+        case 0:
+            index.erase(current);
+            next = expected.erase(next);
+            break;
+        case 1:
+            index.erase(later);
+            expected.erase(later);
+            next = expected.upper_bound(current);
+            break;
+        default:
+            next = expected.upper_bound(current);
+        }
+        cursor.next();
+        steps++;
+    }
+    if (next != expected.end()) mismatches++;
+    cout << "IdIndex cursor check: " << steps << " step(s) over " << count << " keys, " << mismatches
+         << " mismatch(es)\n";
+    return mismatches;
+}
+
+// Admission benchmark: a stream of submissions from four times as many
+// distinct customers as the table holds, plus a few flooders sending one in
+// ten submissions, at 1000 submissions per simulated second
+void runAdmissionBenchmark(long count) {
+    const size_t customers = admissionTable.getCapacity() * 4;
+    const int flooders = 100;
+    vector<string> emails(customers), phones(customers);
+    for (size_t i = 0; i < customers; i++) {
+        emails[i] = "customer" + to_string(i) + "@example.com";
+        phones[i] = "010-" + to_string(10000000 + i);
+    }
+    uint32_t base = (uint32_t)time(nullptr);
+    long admitted = 0, floodAdmitted = 0, floodSubmissions = 0;
+    long long nanos = 0;
+    string email, phone; // Copied first, as a request handler would have them at hand
+    for (long i = 0; i < count; i++) {
+        size_t customer = (size_t)i * 2654435761u % customers;
+        bool flood = i % 10 == 0;
+        if (flood) customer = (size_t)(i / 10) % flooders;
+        email = emails[customer];
+        phone = phones[customer];
+        auto start = chrono::steady_clock::now();
+        AdmissionCheck check = chargeAdmission(email, phone, base + (uint32_t)(i / 1000));
+        nanos += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+        if (check.admitted) {
+            admitted++;
+            check.byEmail->lastComplaintId = (int)i + 1;
+            if (flood) floodAdmitted++;
+        }
+        if (flood) floodSubmissions++;
+    }
+    cout << count << " submissions from " << customers + flooders << " customers\n";
+    cout << "Admitted: " << admitted << ", limited: " << count - admitted << "\n";
+    cout << "Flooders admitted: " << floodAdmitted << " of " << floodSubmissions << "\n";
+    cout << "Buckets: " << admissionTable.getUsed() << "/" << admissionTable.getCapacity() << " ("
+         << admissionTable.memoryBytes() / 1024 << " KB), reused: " << admissionTable.getEvictions() << "\n";
+    cout << "Limiter overhead: " << nanos / max(count, 1L) << " ns per submission\n";
+}
+
+// Blocking FIFO of at most capacity items between two pipeline stages.
+// Either side may close it: pop returns false once it is closed and empty,
+// and push returns false once it is closed.
+template <typename T>
+class BoundedQueue {
+private:
+    deque<T> items;
+    size_t capacity;
+    bool closed;
+    mutex lock;
+    condition_variable notEmpty;
+    condition_variable notFull;
+
+public:
+    explicit BoundedQueue(size_t capacity) : capacity(capacity), closed(false) {}
+
+    bool push(T item) {
+        unique_lock<mutex> guard(lock);
+        notFull.wait(guard, [&] { return items.size() < capacity || closed; });
+        if (closed) return false;
+        items.push_back(move(item));
+        notEmpty.notify_one();
+        return true;
+    }
+
+    bool pop(T& item) {
+        unique_lock<mutex> guard(lock);
+        notEmpty.wait(guard, [&] { return !items.empty() || closed; });
+        if (items.empty()) return false;
+        item = move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    void close() {
+        lock_guard<mutex> guard(lock);
+        closed = true;
+        notEmpty.notify_all();
+        notFull.notify_all();
+    }
+};
+
+// Import/export pipeline settings
+const size_t TRANSFER_BLOCK_SIZE = 1 << 20; // Bytes read or written at a time
+const size_t TRANSFER_BATCH_SIZE = 4096;    // Complaints handed between stages at a time
+const size_t TRANSFER_QUEUE_DEPTH = 4;      // Blocks or batches waiting between two stages
+const int TRANSFER_ERRORS_SHOWN = 5;
+const int TRANSFER_MAX_ID = 1000000000;     // Larger imported IDs are renumbered so new IDs cannot overflow
+const int TRANSFER_CHECKPOINT_SEGMENTS = 64; // Unsaved segments an import holds before saving the store
+
+// Columns of the JSONL and CSV formats, in CSV column order
+enum TransferField {
+    FIELD_ID, FIELD_NAME, FIELD_PHONE, FIELD_EMAIL, FIELD_CONTENT, FIELD_REPLIED, FIELD_REPLY_DETAILS,
+    FIELD_URGENT, FIELD_ORDER, FIELD_SUMMARIZED_BY, FIELD_CREATED_AT, FIELD_REPLIED_AT, TRANSFER_FIELD_COUNT
+};
+const char* const TRANSFER_FIELD_NAMES[TRANSFER_FIELD_COUNT] = {
+    "id", "name", "phone", "email", "content", "replied", "replyDetails",
+    "urgent", "order", "summarizedBy", "createdAt", "repliedAt"};
+
+enum class TransferFormat { JSONL, CSV };
+
+// Picks the format from the file extension (.jsonl/.json or .csv)
+bool transferFormatOf(const string& fileName, TransferFormat& format) {
+    string extension = filesystem::path(fileName).extension().string();
+    transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    if (extension == ".jsonl" || extension == ".json") {
+        format = TransferFormat::JSONL;
+    } else if (extension == ".csv") {
+        format = TransferFormat::CSV;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+int transferFieldIndex(const string& name) {
+    for (int field = 0; field < TRANSFER_FIELD_COUNT; field++) {
+        if (name == TRANSFER_FIELD_NAMES[field]) return field;
+    }
+    return -1;
+}
+
+// Field values of one complaint, as text, in TransferField order
+vector<string> transferValues(const Complaint& complaint) {
+    return {to_string(complaint.id), complaint.customer.getName(), complaint.customer.getPhone(),
+            complaint.customer.getEmail(), complaint.content.plain(), complaint.replied ? "true" : "false",
+            complaint.replyDetails.plain(), complaint.urgent ? "true" : "false", to_string(complaint.order),
+            complaint.summarizedBy, to_string((long long)complaint.createdAt),
+            to_string((long long)complaint.repliedAt)};
+}
+
+bool isTextField(int field) {
+    return field == FIELD_NAME || field == FIELD_PHONE || field == FIELD_EMAIL || field == FIELD_CONTENT
+           || field == FIELD_REPLY_DETAILS || field == FIELD_SUMMARIZED_BY;
+}
+
+void appendJsonString(string& out, const string& text) {
+    out += '"';
+    for (unsigned char c : text) {
+        switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (c < 0x20) {
+                char escaped[8];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                out += escaped;
+            } else {
+                out += (char)c; // UTF-8 passes through unchanged
+            }
+        }
+    }
+    out += '"';
+}
+
+// Quotes a CSV field when it holds a comma, quote, line break or edge space
+void appendCsvField(string& out, const string& text) {
+    bool quote = !text.empty() && (text.front() == ' ' || text.back() == ' ');
+    quote = quote || text.find_first_of(",\"\r\n") != string::npos;
+    if (!quote) {
+        out += text;
+        return;
+    }
+    out += '"';
+    for (char c : text) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    out += '"';
+}
+
+void appendTransferRecord(string& out, const Complaint& complaint, TransferFormat format) {
+    vector<string> values = transferValues(complaint);
+    if (format == TransferFormat::CSV) {
+        for (int field = 0; field < TRANSFER_FIELD_COUNT; field++) {
+            if (field > 0) out += ',';
+            appendCsvField(out, values[field]);
+        }
+        out += "\r\n";
+        return;
+    }
+    out += '{';
+    for (int field = 0; field < TRANSFER_FIELD_COUNT; field++) {
+        if (field > 0) out += ',';
+        appendJsonString(out, TRANSFER_FIELD_NAMES[field]);
+        out += ':';
+        if (isTextField(field)) {
+            appendJsonString(out, values[field]);
+        } else {
+            out += values[field];
+        }
+    }
+    out += "}\n";
+}
+
+// Reads a JSON string starting at the opening quote; pos ends past the closing quote
+bool parseJsonString(const string& text, size_t& pos, string& value) {
+    value.clear();
+    for (pos++; pos < text.size(); pos++) {
+        char c = text[pos];
+        if (c == '"') {
+            pos++;
+            return true;
+        }
+        if (c != '\\') {
+            value += c;
+            continue;
+        }
+        if (++pos >= text.size()) return false;
+        switch (text[pos]) {
+        case 'n': value += '\n'; break;
+        case 'r': value += '\r'; break;
+        case 't': value += '\t'; break;
+        case 'b': value += '\b'; break;
+        case 'f': value += '\f'; break;
+        case 'u': {
+            if (pos + 4 >= text.size()) return false;
+            unsigned code = (unsigned)strtoul(text.substr(pos + 1, 4).c_str(), nullptr, 16);
+            pos += 4;
+            if (code >= 0xD800 && code < 0xDC00 && text.compare(pos + 1, 2, "\\u") == 0 && pos + 6 < text.size()) {
+                unsigned low = (unsigned)strtoul(text.substr(pos + 3, 4).c_str(), nullptr, 16);
+                code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                pos += 6;
+            }
+            // Encode the code point as UTF-8
+            if (code < 0x80) {
+                value += (char)code;
+            } else if (code < 0x800) {
+                value += (char)(0xC0 | code >> 6);
+                value += (char)(0x80 | (code & 0x3F));
+            } else if (code < 0x10000) {
+                value += (char)(0xE0 | code >> 12);
+                value += (char)(0x80 | (code >> 6 & 0x3F));
+                value += (char)(0x80 | (code & 0x3F));
+            } else {
+                value += (char)(0xF0 | code >> 18);
+                value += (char)(0x80 | (code >> 12 & 0x3F));
+                value += (char)(0x80 | (code >> 6 & 0x3F));
+                value += (char)(0x80 | (code & 0x3F));
+            }
+            break;
+        }
+        default: value += text[pos]; // \" \\ \/
+        }
+    }
+    return false;
+}
+
+// Parses one flat JSON object; values of unknown keys are skipped
+bool parseJsonRecord(const string& line, vector<string>& values, vector<bool>& present, string& error) {
+    size_t pos = line.find_first_not_of(" \t\r");
+    if (pos == string::npos || line[pos] != '{') {
+        error = "expected a JSON object";
+        return false;
+    }
+    pos++;
+    string key, value;
+    auto skipSpace = [&]() {
+        while (pos < line.size() && isspace((unsigned char)line[pos])) pos++;
+    };
+    while (true) {
+        skipSpace();
+        if (pos < line.size() && line[pos] == '}') return true;
+        if (pos >= line.size() || line[pos] != '"' || !parseJsonString(line, pos, key)) {
+            error = "expected a field name";
+            return false;
+        }
+        skipSpace();
+        if (pos >= line.size() || line[pos] != ':') {
+            error = "expected ':' after \"" + key + "\"";
+            return false;
+        }
+        pos++;
+        skipSpace();
+        if (pos < line.size() && line[pos] == '"') {
+            if (!parseJsonString(line, pos, value)) {
+                error = "unterminated string in \"" + key + "\"";
+                return false;
+            }
+        } else {
+            size_t end = line.find_first_of(",} \t\r", pos);
+            if (end == string::npos || end == pos || line[pos] == '{' || line[pos] == '[') {
+                error = "unsupported value for \"" + key + "\"";
+                return false;
+            }
+            value = line.substr(pos, end - pos);
+            pos = end;
+            if (value == "null") value.clear();
+        }
+        int field = transferFieldIndex(key);
+        if (field >= 0) {
+            values[field] = value;
+            present[field] = true;
+        }
+        skipSpace();
+        if (pos < line.size() && line[pos] == ',') {
+            pos++;
+        } else if (pos >= line.size() || line[pos] != '}') {
+            error = "expected ',' or '}'";
+            return false;
+        }
+    }
+}
+
+// Incremental RFC 4180 parser: takes blocks that may split records, quoted
+// fields and line breaks anywhere, and hands back each complete row
+class CsvParser {
+private:
+    vector<string> row;
+    string field;
+    bool inQuotes;
+    bool quoteSeen;   // A quote inside a quoted field: either "" or the closing quote
+    bool rowStarted;
+
+    void endField() {
+        row.push_back(move(field));
+        field.clear();
+    }
+
+public:
+    CsvParser() : inQuotes(false), quoteSeen(false), rowStarted(false) {}
+
+    template <typename RowHandler>
+    void feed(const string& block, RowHandler onRow) {
+        for (char c : block) {
+            if (quoteSeen) {
+                quoteSeen = false;
+                if (c == '"') {
+                    field += '"';
+                    continue;
+                }
+                inQuotes = false;
+            }
+            if (inQuotes) {
+                if (c == '"') {
+                    quoteSeen = true;
+                } else {
+                    field += c;
+                }
+                continue;
+            }
+            if (c == '"' && field.empty()) {
+                inQuotes = true;
+                rowStarted = true;
+            } else if (c == ',') {
+                endField();
+                rowStarted = true;
+            } else if (c == '\n') {
+                if (rowStarted || !field.empty()) {
+                    endField();
+                    onRow(row);
+                }
+                row.clear();
+                rowStarted = false;
+            } else if (c != '\r') {
+                field += c;
+                rowStarted = true;
+            }
+        }
+    }
+
+    // Ends the last row when the input does not end with a line break
+    template <typename RowHandler>
+    void finish(RowHandler onRow) {
+        if (quoteSeen) inQuotes = false;
+        if (rowStarted || !field.empty()) {
+            endField();
+            onRow(row);
+        }
+        row.clear();
+    }
+};
+
+bool parseBoolValue(const string& text) {
+    string lower = text;
+    transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    return lower == "true" || lower == "1" || lower == "yes";
+}
+
+// Builds a complaint from parsed field values. The email and content are
+// required; missing times are left unknown.
+bool buildTransferComplaint(const vector<string>& values, const vector<bool>& present, Complaint& complaint,
+                            string& error) {
+    if (!present[FIELD_EMAIL] || !isValidEmail(values[FIELD_EMAIL])) {
+        error = "missing or invalid email";
+        return false;
+    }
+    if (!present[FIELD_CONTENT] || values[FIELD_CONTENT].empty()) {
+        error = "missing content";
+        return false;
+    }
+    complaint.id = present[FIELD_ID] ? atoi(values[FIELD_ID].c_str()) : 0;
+    complaint.customer = Customer(values[FIELD_NAME], values[FIELD_PHONE], values[FIELD_EMAIL]);
+    complaint.content = values[FIELD_CONTENT];
+    complaint.replyDetails = values[FIELD_REPLY_DETAILS];
+    complaint.replied = present[FIELD_REPLIED] ? parseBoolValue(values[FIELD_REPLIED])
+                                               : !values[FIELD_REPLY_DETAILS].empty();
+    complaint.urgent = parseBoolValue(values[FIELD_URGENT]);
+    complaint.order = atoi(values[FIELD_ORDER].c_str());
+    complaint.summarizedBy = values[FIELD_SUMMARIZED_BY];
+    complaint.createdAt = (time_t)atoll(values[FIELD_CREATED_AT].c_str());
+    complaint.repliedAt = (time_t)atoll(values[FIELD_REPLIED_AT].c_str());
+    return true;
+}
+
+// Adds an imported complaint. Its ID is kept when no complaint holds it, so
+// an export imported into an empty system keeps its numbering; complaints
+// without an ID, with one in use or with one above TRANSFER_MAX_ID get the
+// next ID. Replied complaints go straight to the cold tier, so large imports
+// do not grow the hot set. Returns true if a given ID had to be replaced.
+bool storeImportedComplaint(Complaint& complaint) {
+    bool keep = complaint.id > 0 && complaint.id <= TRANSFER_MAX_ID
+                && (complaint.id > Complaint::lastId || findComplaint(complaint.id) == nullptr);
+    bool renumbered = complaint.id > 0 && !keep;
+    if (!keep) complaint.id = Complaint::lastId + 1;
+    Complaint::lastId = max(Complaint::lastId, complaint.id);
+    filterIndex.update(complaint);
+    if (changeLog.isEnabled()) changeLog.record("ADD", encodeComplaint(complaint));
+    if (complaint.replied && !complaint.urgent) {
+        coldStore.evict(complaint);
+        return renumbered;
+    }
+    Complaint* stored = emplaceComplaint(move(complaint));
+    restoreUrgent(*stored);
+    scheduleSlaTimer(*stored, -1);
+    return renumbered;
+}
+
+void printTransferRate(long records, unsigned long long bytes, chrono::steady_clock::time_point start) {
+    double seconds = max(chrono::duration<double>(chrono::steady_clock::now() - start).count(), 1e-9);
+    cout << records << " complaint(s), " << bytes / 1024 << " KB in " << (long)(seconds * 1000) << " ms ("
+         << (long)(bytes / seconds / (1 << 20)) << " MB/s)\n";
+}
+
+// Streams every complaint to fileName in ID order through three stages: this
+// thread pages complaints out of the store, a formatter thread encodes them
+// and a writer thread writes the blocks, with bounded queues in between
+void exportComplaints(const string& fileName, TransferFormat format) {
+    ofstream outFile(fileName, ios::binary);
+    if (!outFile.is_open()) {
+        cout << "Error: Unable to open " << fileName << " for writing!\n";
+        return;
+    }
+    auto start = chrono::steady_clock::now();
+    BoundedQueue<vector<Complaint>> batches(TRANSFER_QUEUE_DEPTH);
+    BoundedQueue<string> blocks(TRANSFER_QUEUE_DEPTH);
+    unsigned long long bytes = 0;
+    bool writeFailed = false;
+
+    thread formatter([&]() {
+        string block;
+        if (format == TransferFormat::CSV) {
+            for (int field = 0; field < TRANSFER_FIELD_COUNT; field++) {
+                block += field > 0 ? "," : "";
+                block += TRANSFER_FIELD_NAMES[field];
+            }
+            block += "\r\n";
+        }
+        vector<Complaint> batch;
+        while (batches.pop(batch)) {
+            for (const Complaint& complaint : batch) {
+                appendTransferRecord(block, complaint, format);
+            }
+            if (block.size() >= TRANSFER_BLOCK_SIZE) {
+                if (!blocks.push(move(block))) break;
+                block.clear();
+            }
+        }
+        if (!block.empty()) blocks.push(move(block));
+        blocks.close();
+        batches.close(); // Stops the store stage early if the writer failed
+    });
+    thread writer([&]() {
+        string block;
+        while (blocks.pop(block)) {
+            if (!outFile.write(block.data(), block.size())) {
+                writeFailed = true;
+                blocks.close();
+                break;
+            }
+            bytes += block.size();
+        }
+    });
+
+    long records = 0;
+    int nextId = 1;
+    while (true) {
+        vector<Complaint> batch = collectComplaintRange(nextId, numeric_limits<int>::max(), TRANSFER_BATCH_SIZE);
+        if (batch.empty()) break;
+        records += batch.size();
+        int lastId = batch.back().id;
+        if (!batches.push(move(batch)) || lastId == numeric_limits<int>::max()) break;
+        nextId = lastId + 1;
+    }
+    batches.close();
+    formatter.join();
+    writer.join();
+    outFile.close();
+    if (writeFailed || !outFile) {
+        cout << "Error: Writing " << fileName << " failed!\n";
+        return;
+    }
+    cout << "Exported ";
+    printTransferRate(records, bytes, start);
+}
+
+// Streams complaints from fileName into the store through three stages: a
+// reader thread reads blocks, a parser thread turns them into complaints and
+// this thread inserts them, with bounded queues in between
+void importComplaints(const string& fileName, TransferFormat format) {
+    ifstream inFile(fileName, ios::binary);
+    if (!inFile.is_open()) {
+        cout << "Error: Unable to open " << fileName << "!\n";
+        return;
+    }
+    auto start = chrono::steady_clock::now();
+    BoundedQueue<string> blocks(TRANSFER_QUEUE_DEPTH);
+    BoundedQueue<vector<Complaint>> batches(TRANSFER_QUEUE_DEPTH);
+    unsigned long long bytes = 0;
+    long skipped = 0;
+    vector<string> errors; // The first few, with their record numbers
+
+    thread reader([&]() {
+        while (inFile) {
+            string block(TRANSFER_BLOCK_SIZE, '\0');
+            inFile.read(&block[0], block.size());
+            block.resize(inFile.gcount());
+            if (block.empty()) break;
+            bytes += block.size();
+            if (!blocks.push(move(block))) break;
+        }
+        blocks.close();
+    });
+    thread parser([&]() {
+        vector<Complaint> batch;
+        vector<string> values(TRANSFER_FIELD_COUNT);
+        vector<bool> present(TRANSFER_FIELD_COUNT);
+        long recordNumber = 0;
+        auto addRecord = [&](bool parsed, const string& parseError) {
+            recordNumber++;
+            string error = parseError;
+            Complaint complaint;
+            if (parsed && buildTransferComplaint(values, present, complaint, error)) {
+                batch.push_back(move(complaint));
+                if (batch.size() >= TRANSFER_BATCH_SIZE) {
+                    batches.push(move(batch));
+                    batch.clear();
+                }
+                return;
+            }
+            skipped++;
+            if ((int)errors.size() < TRANSFER_ERRORS_SHOWN) {
+                errors.push_back("Record " + to_string(recordNumber) + ": " + error);
+            }
+        };
+
+        CsvParser csv;
+        vector<int> columns; // CSV column -> TransferField, -1 for unknown columns
+        auto onRow = [&](const vector<string>& row) {
+            if (columns.empty()) {
+                for (const string& name : row) columns.push_back(transferFieldIndex(name));
+                return;
+            }
+            fill(values.begin(), values.end(), string());
+            fill(present.begin(), present.end(), false);
+            for (size_t i = 0; i < row.size() && i < columns.size(); i++) {
+                if (columns[i] < 0) continue;
+                values[columns[i]] = row[i];
+                present[columns[i]] = true;
+            }
+            addRecord(true, "");
+        };
+        string partial; // JSONL line split across blocks
+        auto onLine = [&](const string& line) {
+            if (line.find_first_not_of(" \t\r") == string::npos) return;
+            fill(values.begin(), values.end(), string());
+            fill(present.begin(), present.end(), false);
+            string error;
+            addRecord(parseJsonRecord(line, values, present, error), error);
+        };
+
+        string block;
+        while (blocks.pop(block)) {
+            if (format == TransferFormat::CSV) {
+                csv.feed(block, onRow);
+                continue;
+            }
+            size_t start = 0, newline;
+            while ((newline = block.find('\n', start)) != string::npos) {
+                if (partial.empty()) {
+                    onLine(block.substr(start, newline - start));
+                } else {
+                    onLine(partial + block.substr(start, newline - start));
+                    partial.clear();
+                }
+                start = newline + 1;
+            }
+            partial.append(block, start, string::npos);
+        }
+        if (format == TransferFormat::CSV) {
+            csv.finish(onRow);
+        } else {
+            onLine(partial);
+        }
+        if (!batch.empty()) batches.push(move(batch));
+        batches.close();
+    });
+
+    long records = 0, renumbered = 0;
+    vector<Complaint> batch;
+    while (batches.pop(batch)) {
+        for (Complaint& complaint : batch) {
+            if (storeImportedComplaint(complaint)) renumbered++;
+            records++;
+        }
+        // Cold segments stay in memory until saved, so save as they pile up
+        if (coldStore.getDirtySegments() >= TRANSFER_CHECKPOINT_SEGMENTS && !writeComplaintData()) {
+            cout << "Error: Unable to open file for writing!\n";
+        }
+    }
+    reader.join();
+    parser.join();
+    cout << "Imported ";
+    printTransferRate(records, bytes, start);
+    if (renumbered > 0) cout << renumbered << " complaint(s) got new IDs (their IDs were in use or too large)\n";
+    if (skipped > 0) {
+        cout << "Skipped " << skipped << " invalid record(s):\n";
+        for (const string& error : errors) cout << "  " << error << "\n";
+    }
+}
+
+void transferComplaints(bool import) {
+    string fileName;
+    cout << "Enter file name (.jsonl or .csv): ";
+    getline(cin >> ws, fileName);
+    TransferFormat format;
+    if (!transferFormatOf(fileName, format)) {
+        cout << "Unsupported file type; use .jsonl or .csv\n";
+        return;
+    }
+    if (import) {
+        importComplaints(fileName, format);
+    } else {
+        exportComplaints(fileName, format);
+    }
+}
+
+// Compression dictionary persistence
+void loadCompressionDictionary() {
+    ifstream inFile(DICTIONARY_FILE);
+    if (!inFile.is_open()) return;
+    readDataFileHeader(inFile);
+    int generations;
+    inFile >> generations;
+    for (int g = 0; g < generations; g++) {
+        int entries;
+        inFile >> entries;
+        inFile.ignore();
+        TextDictionary dictionary;
+        string entry;
+        for (int i = 0; i < entries && getline(inFile, entry); i++) {
+            dictionary.addEntry(entry);
+        }
+        textDictionaries.push_back(dictionary);
+    }
+}
+
+// Entries are words with an optional trailing space, one per line
+void saveCompressionDictionary() {
+    ofstream outFile(DICTIONARY_FILE);
+    if (!outFile.is_open()) {
+        cout << "Error: Unable to write compression dictionary!\n";
+        return;
+    }
+    outFile << "# complaint-dictionary v1\n";
+    outFile << textDictionaries.size() << "\n";
+    for (const TextDictionary& dictionary : textDictionaries) {
+        outFile << dictionary.getEntries().size() << "\n";
+        for (const string& entry : dictionary.getEntries()) {
+            outFile << entry << "\n";
+        }
+    }
+}
+
+void trainCompressionDictionary() {
+    vector<string> samples;
+    for (const Complaint& complaint : complaintQueue) {
+        samples.push_back(complaint.content.plain());
+        samples.push_back(complaint.replyDetails.plain());
+    }
+    TextDictionary dictionary;
+    dictionary.train(samples);
+    if (dictionary.empty()) {
+        cout << "Not enough repeated text to train a dictionary.\n";
+        return;
+    }
+    textDictionaries.push_back(dictionary);
+    saveCompressionDictionary();
+
+    // Re-encode the hot set; older records keep decoding with their generation
+    for (Complaint& complaint : complaintQueue) {
+        complaint.content = complaint.content.plain();
+        complaint.replyDetails = complaint.replyDetails.plain();
+    }
+    cout << "Dictionary generation " << textDictionaries.size() << " trained with "
+         << dictionary.getEntries().size() << " entries.\n";
+}
+
+void showCompressionStats() {
+    size_t plainBytes = 0, storedBytes = 0;
+    int compressedFields = 0, fields = 0;
+    auto measure = [&](const CompressedText& text) {
+        plainBytes += text.plain().size();
+        storedBytes += text.storedSize();
+        fields++;
+        if (text.isCompressed()) compressedFields++;
+    };
+    for (const Complaint& complaint : complaintQueue) {
+        measure(complaint.content);
+        measure(complaint.replyDetails);
+    }
+
+    cout << "=========================================\n";
+    cout << "Compression Stats (hot complaints)\n";
+    cout << "Dictionary generations: " << textDictionaries.size();
+    if (!textDictionaries.empty()) {
+        cout << " (latest has " << textDictionaries.back().getEntries().size() << " entries)";
+    }
+    cout << "\n";
+    cout << "Compressed fields: " << compressedFields << "/" << fields << "\n";
+    cout << "Text bytes: " << plainBytes << " plain, " << storedBytes << " stored\n";
+    if (storedBytes > 0) {
+        cout << "Compression ratio: " << (double)plainBytes / storedBytes << "\n";
+    }
+    cout << "Memory saved: " << (long)plainBytes - (long)storedBytes << " bytes\n";
+    cout << "Decodes on display/search paths: " << compressionStats.decodes << "\n";
+    if (compressionStats.decodes > 0) {
+        cout << "Average decode latency: "
+             << compressionStats.decodeNanos / compressionStats.decodes << " ns\n";
+    }
+    cout << "=========================================\n";
+}
+
+// File I/O functions
+void loadComplaintDataFromFile() {
+    loadCompressionDictionary();
+    ifstream inFile("complaint_data.txt");
+    if (!inFile.is_open()) {
+        cout << "No complaint data file found. Starting empty.\n";
+        coldStore.open();
+        rescheduleSlaTimers();
+        return;
+    }
+
+    int version = readDataFileHeader(inFile);
+    Complaint complaint;
+    while (readComplaintRecord(inFile, complaint, version)) {
+        if (complaint.id > Complaint::lastId) Complaint::lastId = complaint.id;
+        Complaint* stored = emplaceComplaint(move(complaint));
+        restoreUrgent(*stored);
+    }
+    inFile.close();
+    coldStore.open();
+    rescheduleSlaTimers();
+    cout << "Complaint data loaded successfully!\n";
+}
+
+// Evicts cold complaints to their segments, then writes the hot set
+void saveComplaintDataToFile() {
+    if (!writeComplaintData()) {
+        cout << "Error: Unable to open file for writing!\n";
+        return;
+    }
+    cout << "Complaint data saved successfully!\n";
+}
+
+#ifdef __linux__
+// Network server: one thread runs an epoll loop over many TCP or Unix socket
+// clients. Every client is a non-blocking session with its own input and
+// output buffers and the menu it is in, and speaks a line protocol that
+// mirrors the console menus. Each response is a status line ("OK ..." or
+// "ERR message"), the body, and a line holding only "."; body lines starting
+// with '.' get an extra '.' so the terminator stays unambiguous.
+const int SERVER_MAX_EVENTS = 256;
+const int SERVER_TICK_MS = 1000;                     // SLA timers run at least this often
+const size_t SERVER_READ_CHUNK = 16 * 1024;
+const size_t SERVER_MAX_LINE = 64 * 1024;            // Longer requests close the session
+const size_t SERVER_MAX_PENDING_OUTPUT = 1 << 20;    // Stop reading while more is queued
+const size_t SERVER_LIST_LIMIT = 1000;               // Rows returned by RANGE and FILTER
+const size_t SERVER_SCAN_PAGE = 1000;                // Complaints read per loop iteration by paged requests
+
+enum class SessionMenu { MAIN, CUSTOMER, EMPLOYEE, ADMIN, REPLICA }; // REPLICA: a replica's change feed
+
+// Requests that read every complaint, cold segments included, run one page
+// per loop iteration so other sessions keep being served meanwhile
+enum class SessionScan { NONE, HISTORY, FILTER, SNAPSHOT };
+
+struct ClientSession {
+    int fd;
+    SessionMenu menu;
+    string input;
+    string output;
+    size_t outputSent;
+    uint32_t events;  // Events currently registered with epoll
+    bool closing;     // Close once the output is flushed
+    long ackedSequence; // Replica feeds: last change the replica applied
+    chrono::steady_clock::time_point ackedAt;
+    SessionScan scan;   // Paged request in progress
+    string scanArgs;
+    string scanBody;    // Response body gathered so far
+    int scanCursor;     // Last complaint ID covered
+    int scanCount;      // Complaints matched or sent
+
+    explicit ClientSession(int fd)
+        : fd(fd), menu(SessionMenu::MAIN), outputSent(0), events(0), closing(false), ackedSequence(0),
+          scan(SessionScan::NONE), scanCursor(0), scanCount(0) {}
+
+    size_t pendingOutput() const { return output.size() - outputSent; }
+
+    // Later requests wait until a paged HISTORY or FILTER has answered
+    bool holdsRequests() const { return scan == SessionScan::HISTORY || scan == SessionScan::FILTER; }
+};
+
+volatile sig_atomic_t serverStopRequested = 0;
+
+void requestServerStop(int) {
+    serverStopRequested = 1;
+}
+
+// Lets one process hold as many sockets as the hard limit allows
+void raiseFileLimit() {
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+bool setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+// Endpoints are a TCP port on 127.0.0.1 or "unix:<path>". Fills address and
+// returns its length, or 0 if the endpoint is malformed.
+socklen_t parseEndpoint(const string& endpoint, sockaddr_storage& address) {
+    memset(&address, 0, sizeof(address));
+    if (endpoint.compare(0, 5, "unix:") == 0) {
+        sockaddr_un* unixAddress = (sockaddr_un*)&address;
+        string path = endpoint.substr(5);
+        if (path.empty() || path.size() >= sizeof(unixAddress->sun_path)) return 0;
+        unixAddress->sun_family = AF_UNIX;
+        memcpy(unixAddress->sun_path, path.c_str(), path.size() + 1);
+        return sizeof(sockaddr_un);
+    }
+    char* end;
+    long port = strtol(endpoint.c_str(), &end, 10);
+    if (endpoint.empty() || *end != '\0' || port <= 0 || port > 65535) return 0;
+    sockaddr_in* inetAddress = (sockaddr_in*)&address;
+    inetAddress->sin_family = AF_INET;
+    inetAddress->sin_port = htons((uint16_t)port);
+    inetAddress->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return sizeof(sockaddr_in);
+}
+
+int openListenSocket(const string& endpoint) {
+    sockaddr_storage address;
+    socklen_t length = parseEndpoint(endpoint, address);
+    if (length == 0) {
+        cout << "Invalid endpoint: " << endpoint << " (use a port or unix:<path>)\n";
+        return -1;
+    }
+    int fd = socket(address.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        perror("socket");
+        return -1;
+    }
+    if (address.ss_family == AF_UNIX) {
+        unlink(((sockaddr_un*)&address)->sun_path); // Stale socket from an earlier run
+    } else {
+        int reuse = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    }
+    if (bind(fd, (sockaddr*)&address, length) < 0 || listen(fd, SOMAXCONN) < 0) {
+        perror("bind/listen");
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Connects a blocking socket, then switches it to non-blocking mode
+int connectEndpoint(const string& endpoint) {
+    sockaddr_storage address;
+    socklen_t length = parseEndpoint(endpoint, address);
+    if (length == 0) return -1;
+    int fd = socket(address.ss_family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    if (connect(fd, (sockaddr*)&address, length) < 0 || !setNonBlocking(fd)) {
+        close(fd);
+        return -1;
+    }
+    if (address.ss_family == AF_INET) {
+        int noDelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    }
+    return fd;
+}
+
+void appendResponse(string& output, const string& status, const string& body) {
+    output += status;
+    output += '\n';
+    size_t start = 0;
+    while (start < body.size()) {
+        size_t end = body.find('\n', start);
+        if (end == string::npos) end = body.size();
+        if (body[start] == '.') output += '.';
+        output.append(body, start, end - start);
+        output += '\n';
+        start = end + 1;
+    }
+    output += ".\n";
+}
+
+// Splits "a|b|c" into at most count fields; the last field keeps any
+// further '|' characters so free text can contain them
+vector<string> splitFields(const string& text, size_t count) {
+    vector<string> fields;
+    size_t start = 0;
+    while (fields.size() + 1 < count) {
+        size_t bar = text.find('|', start);
+        if (bar == string::npos) break;
+        fields.push_back(text.substr(start, bar - start));
+        start = bar + 1;
+    }
+    fields.push_back(text.substr(start));
+    return fields;
+}
+
+bool parseIntField(const string& text, int& value) {
+    char* end;
+    errno = 0;
+    long parsed = strtol(text.c_str(), &end, 10);
+    if (text.empty() || *end != '\0' || errno != 0 || parsed < numeric_limits<int>::min()
+        || parsed > numeric_limits<int>::max()) {
+        return false;
+    }
+    value = (int)parsed;
+    return true;
+}
+
+// Replication: a primary server streams its change log to replica servers
+// that connect with REPLICATE. A feed starts with "SNAPSHOT <sequence>", one
+// "PUT <complaint>" line per stored complaint, "SUMMARIES" followed by a
+// "PUSH <complaint>" line per summary stack entry from the bottom up, and
+// "LIVE <sequence>", then
+// carries every change log line plus a "HEARTBEAT <sequence> <wall clock us>"
+// each tick. The snapshot is sent in ID order a page at a time as the feed
+// drains; meanwhile only changes to complaints already sent are forwarded,
+// as later pages carry the rest. Replicas answer with "ACK <sequence>" and
+// serve read-only queries once the snapshot is complete, until they are
+// promoted.
+const size_t REPLICA_MAX_BACKLOG = 64 << 20; // Feeds further behind than this are dropped
+
+unordered_map<int, ClientSession> serverSessions;
+vector<int> replicaFeeds;     // Sessions receiving the change log
+vector<int> scanningSessions; // Sessions with a paged request in progress
+
+// A replica's connection to its primary
+struct PrimaryLink {
+    string endpoint;
+    int fd;
+    string input;
+    long appliedSequence;        // Last change applied here
+    long primarySequence;        // Latest sequence announced by the primary
+    long long applyDelayMicros;  // Primary-to-replica delay of the last applied change
+    long applied;
+    long failed;
+    bool live;                   // The whole snapshot has arrived
+    chrono::steady_clock::time_point heartbeatAt;
+
+    PrimaryLink()
+        : fd(-1), appliedSequence(0), primarySequence(0), applyDelayMicros(0), applied(0), failed(0), live(false) {}
+};
+
+PrimaryLink primaryLink;
+bool serverReadOnly = false; // Replicas refuse changes until promoted
+
+// A replica without its full snapshot has only part of the store
+bool replicaSyncing() {
+    return serverReadOnly && !primaryLink.live;
+}
+
+bool isChangeCommand(const string& command) {
+    return command == "ADD" || command == "DELETE" || command == "REPLY" || command == "SUMMARY"
+           || command == "ADDEMP" || command == "DELEMP" || command == "MARKURGENT" || command == "SAVE";
+}
+
+long millisSince(chrono::steady_clock::time_point start) {
+    return (long)chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+}
+
+// Queues the changes recorded since the last call on every replica feed.
+// Feeds still receiving their snapshot only get changes to complaints that
+// were already sent.
+void shipChanges() {
+    string lines = changeLog.take();
+    if (lines.empty()) return;
+    for (int fd : replicaFeeds) {
+        ClientSession& feed = serverSessions.at(fd);
+        if (feed.scan != SessionScan::SNAPSHOT) {
+            feed.output += lines;
+            continue;
+        }
+        size_t start = 0, newline;
+        while ((newline = lines.find('\n', start)) != string::npos) {
+            // "<sequence> <wall clock us> <OP> <complaint id>|..."
+            size_t fields = lines.find(' ', lines.find(' ', lines.find(' ', start) + 1) + 1) + 1;
+            if (atoi(lines.c_str() + fields) <= feed.scanCursor) {
+                feed.output.append(lines, start, newline + 1 - start);
+            }
+            start = newline + 1;
+        }
+    }
+}
+
+void sendHeartbeats() {
+    string heartbeat = "HEARTBEAT " + to_string(changeLog.getSequence()) + " " + to_string(wallClockMicros()) + "\n";
+    for (int fd : replicaFeeds) {
+        serverSessions.at(fd).output += heartbeat;
+    }
+}
+
+void startSessionScan(ClientSession& session, SessionScan scan, const string& args) {
+    session.scan = scan;
+    session.scanArgs = args;
+    session.scanBody.clear();
+    session.scanCursor = 0;
+    session.scanCount = 0;
+    scanningSessions.push_back(session.fd);
+}
+
+// Turns a session into a replica feed: a snapshot of the store as of the
+// current sequence, then every later change as it is made
+void startReplicaFeed(ClientSession& session) {
+    shipChanges(); // Changes recorded so far are part of the snapshot
+    session.menu = SessionMenu::REPLICA;
+    session.ackedAt = chrono::steady_clock::now();
+    session.output += "SNAPSHOT " + to_string(changeLog.getSequence()) + "\n";
+    startSessionScan(session, SessionScan::SNAPSHOT, "");
+    replicaFeeds.push_back(session.fd);
+    cout << "Replica connected; sending snapshot from sequence " << changeLog.getSequence() << "\n";
+}
+
+// Applies one line of the primary's feed; false if the primary refused
+bool applyFeedLine(const string& line) {
+    if (line.compare(0, 4, "PUT ") == 0) {
+        if (!applyChange("ADD", line.substr(4))) primaryLink.failed++;
+    } else if (line.compare(0, 5, "PUSH ") == 0) {
+        Complaint complaint;
+        if (decodeComplaint(line.substr(5), complaint)) {
+            summaryStack.push(move(complaint));
+        } else {
+            primaryLink.failed++;
+        }
+    } else if (line == "SUMMARIES") {
+        while (!summaryStack.isEmpty()) summaryStack.pop();
+    } else if (line.compare(0, 9, "SNAPSHOT ") == 0) {
+        primaryLink.appliedSequence = primaryLink.primarySequence = atol(line.c_str() + 9);
+    } else if (line.compare(0, 4, "LIVE") == 0) {
+        primaryLink.appliedSequence = max(primaryLink.appliedSequence, atol(line.c_str() + 4));
+        primaryLink.primarySequence = max(primaryLink.primarySequence, primaryLink.appliedSequence);
+        primaryLink.live = true;
+        cout << "Snapshot loaded: " << totalComplaintCount() << " complaints at sequence "
+             << primaryLink.appliedSequence << "\n";
+    } else if (line.compare(0, 10, "HEARTBEAT ") == 0) {
+        primaryLink.primarySequence = max(primaryLink.primarySequence, atol(line.c_str() + 10));
+        primaryLink.heartbeatAt = chrono::steady_clock::now();
+    } else if (line.compare(0, 3, "ERR") == 0) {
+        cout << "Primary refused replication: " << line << "\n";
+        return false;
+    } else {
+        // "<sequence> <wall clock us> <OP> <fields>"
+        size_t first = line.find(' ');
+        size_t second = line.find(' ', first + 1);
+        size_t third = line.find(' ', second + 1);
+        if (third == string::npos) {
+            primaryLink.failed++;
+            return true;
+        }
+        long sequence = atol(line.c_str());
+        long long recordedAt = atoll(line.c_str() + first + 1);
+        if (applyChange(line.substr(second + 1, third - second - 1), line.substr(third + 1))) {
+            primaryLink.applied++;
+        } else {
+            primaryLink.failed++;
+        }
+        primaryLink.appliedSequence = sequence;
+        primaryLink.primarySequence = max(primaryLink.primarySequence, sequence);
+        primaryLink.applyDelayMicros = wallClockMicros() - recordedAt;
+    }
+    return true;
+}
+
+// Reads and applies the primary's feed, then acknowledges the last applied
+// sequence; false once the link is lost
+bool readPrimaryLink() {
+    char buffer[SERVER_READ_CHUNK];
+    ssize_t received = recv(primaryLink.fd, buffer, sizeof(buffer), 0);
+    if (received <= 0) return received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR);
+    primaryLink.input.append(buffer, received);
+    size_t start = 0, newline;
+    while ((newline = primaryLink.input.find('\n', start)) != string::npos) {
+        if (!applyFeedLine(primaryLink.input.substr(start, newline - start))) return false;
+        start = newline + 1;
+    }
+    primaryLink.input.erase(0, start);
+    string ack = "ACK " + to_string(primaryLink.appliedSequence) + "\n";
+    send(primaryLink.fd, ack.data(), ack.size(), MSG_NOSIGNAL); // A dropped ack is superseded by the next one
+    return true;
+}
+
+void closePrimaryLink() {
+    if (primaryLink.fd < 0) return;
+    close(primaryLink.fd); // Closing also removes it from the epoll set
+    primaryLink.fd = -1;
+}
+
+// Stops following the primary and starts accepting changes
+bool promoteReplica() {
+    if (!serverReadOnly) return false;
+    closePrimaryLink();
+    serverReadOnly = false;
+    rescheduleSlaTimers();
+    cout << "Promoted to primary at sequence " << primaryLink.appliedSequence << "\n";
+    return true;
+}
+
+void writeReplicationStatus(ostream& out) {
+    out << "=========================================\n";
+    out << "Replication\n";
+    if (primaryLink.endpoint.empty()) {
+        out << "Role: primary\n";
+    } else {
+        out << "Role: " << (serverReadOnly ? "replica" : "promoted replica") << "\n";
+        out << "Primary: " << primaryLink.endpoint << (primaryLink.fd >= 0 ? " (connected)" : " (disconnected)") << "\n";
+        if (!primaryLink.live) {
+            if (primaryLink.fd >= 0) {
+                out << "Sync: loading snapshot, " << totalComplaintCount() << " complaint(s) so far\n";
+            } else {
+                out << "Sync: FAILED, link lost after " << totalComplaintCount()
+                    << " complaint(s) of the snapshot; data is incomplete\n";
+            }
+        } else {
+            out << "Applied sequence: " << primaryLink.appliedSequence << ", primary sequence: "
+                << primaryLink.primarySequence << ", lag: "
+                << primaryLink.primarySequence - primaryLink.appliedSequence << " change(s)\n";
+            out << "Last change delay: " << primaryLink.applyDelayMicros << " us, heartbeat age: "
+                << millisSince(primaryLink.heartbeatAt) << " ms\n";
+        }
+        out << "Changes applied: " << primaryLink.applied << ", failed: " << primaryLink.failed << "\n";
+    }
+    out << "Change log sequence: " << changeLog.getSequence() << "\n";
+    out << "Replicas: " << replicaFeeds.size() << "\n";
+    for (int fd : replicaFeeds) {
+        const ClientSession& feed = serverSessions.at(fd);
+        if (feed.scan == SessionScan::SNAPSHOT) {
+            out << "Replica " << fd << ": sending snapshot, " << feed.scanCount << " complaint(s) sent, "
+                << feed.pendingOutput() << " bytes queued\n";
+            continue;
+        }
+        out << "Replica " << fd << ": acked " << feed.ackedSequence << ", lag "
+            << changeLog.getSequence() - feed.ackedSequence << " change(s), "
+            << feed.pendingOutput() << " bytes queued, last ack " << millisSince(feed.ackedAt) << " ms ago\n";
+    }
+    out << "=========================================\n";
+}
+
+const char* sessionMenuName(SessionMenu menu) {
+    switch (menu) {
+    case SessionMenu::CUSTOMER: return "Customer";
+    case SessionMenu::EMPLOYEE: return "Employee";
+    case SessionMenu::ADMIN: return "Admin";
+    case SessionMenu::REPLICA: return "Replica feed";
+    default: return "Main";
+    }
+}
+
+void writeServerHelp(ostream& out, SessionMenu menu) {
+    switch (menu) {
+    case SessionMenu::MAIN:
+    case SessionMenu::REPLICA:
+        out << "ROLE CUSTOMER|EMPLOYEE|ADMIN\nREPLICATE\n";
+        break;
+    case SessionMenu::CUSTOMER:
+        out << "ADD name|phone|email|content\nDELETE id\nDETAILS id\nHISTORY email\n";
+        break;
+    case SessionMenu::EMPLOYEE:
+        out << "URGENT\nUNREPLIED\nREPLY id|text\nSUMMARY id|employeeId|text\n";
+        out << "SUMMARIES\nSEARCH text\n";
+        break;
+    case SessionMenu::ADMIN:
+        out << "EMPLOYEES\nADDEMP name|id|password\nDELEMP id\nCOUNT\nUNREPLIED\n";
+        out << "MARKURGENT id|order\nURGENT\nSTATS\nADMISSION\nRANGE from|to\nSLA\nFILTER expression\nSAVE\n";
+        out << "REPLICATION\nPROMOTE\n";
+        break;
+    }
+    out << "HELP\nBACK\nQUIT\n";
+}
+
+// Answers FILTER once the filter index is built
+string writeFilterResult(ostream& out, const string& expression) {
+    RoaringBitmap result;
+    string error;
+    if (!FilterQuery(filterIndex).evaluate(expression, result, error)) return "ERR " + error;
+    size_t listed = 0;
+    result.forEach([&](uint32_t id) {
+        if (listed++ < SERVER_LIST_LIMIT) {
+            out << id << (listed % FILTER_IDS_PER_LINE == 0 ? "\n" : " ");
+        }
+    });
+    if (min(listed, SERVER_LIST_LIMIT) % FILTER_IDS_PER_LINE != 0) out << "\n";
+    return "OK " + to_string(result.cardinality()) + " match(es)";
+}
+
+// Runs one request line and queues its response. Returns the status line;
+// the body is written to out. HISTORY, and FILTER before the filter index is
+// built, are paged instead; see advanceSessionScan.
+string runServerCommand(ClientSession& session, const string& command, const string& args, ostream& out) {
+    if (command == "HELP") {
+        writeServerHelp(out, session.menu);
+        return string("OK ") + sessionMenuName(session.menu) + " menu";
+    }
+    if (command == "QUIT") {
+        session.closing = true;
+        return "OK Goodbye";
+    }
+    if (command == "BACK") {
+        session.menu = SessionMenu::MAIN;
+        return "OK Main menu";
+    }
+    if (command == "ROLE") {
+        string role = args;
+        transform(role.begin(), role.end(), role.begin(), ::toupper);
+        if (role == "CUSTOMER") session.menu = SessionMenu::CUSTOMER;
+        else if (role == "EMPLOYEE") session.menu = SessionMenu::EMPLOYEE;
+        else if (role == "ADMIN") session.menu = SessionMenu::ADMIN;
+        else return "ERR Unknown role: " + args;
+        return string("OK ") + sessionMenuName(session.menu) + " menu";
+    }
+
+    if (serverReadOnly && isChangeCommand(command)) {
+        return "ERR Read-only replica; send changes to the primary or PROMOTE this replica";
+    }
+    if (replicaSyncing() && command != "REPLICATION") {
+        if (primaryLink.fd < 0) return "ERR Replica sync failed; its snapshot is incomplete";
+        return "ERR Replica is still loading its snapshot";
+    }
+
+    int complaintId;
+    if (session.menu == SessionMenu::CUSTOMER) {
+        if (command == "ADD") {
+            vector<string> fields = splitFields(args, 4);
+            if (fields.size() != 4) return "ERR Usage: ADD name|phone|email|content";
+            if (!isValidEmail(fields[2])) return "ERR Invalid email format!";
+            if (fields[3].empty()) return "ERR Complaint content cannot be empty!";
+            Admission admission;
+            Complaint* stored = submitComplaint(fields[0], fields[1], fields[2], fields[3], admission);
+            if (admission == Admission::REJECTED) return "ERR Too many complaints submitted recently; try again later";
+            return "OK " + to_string(stored->id) + (admission == Admission::MERGED ? " merged" : "");
+        }
+        if (command == "DELETE") {
+            if (!parseIntField(args, complaintId)) return "ERR Usage: DELETE id";
+            if (!removeComplaint(complaintId)) return "ERR Complaint ID " + args + " not found!";
+            return "OK Complaint ID " + args + " deleted";
+        }
+        if (command == "DETAILS") {
+            if (!parseIntField(args, complaintId)) return "ERR Usage: DETAILS id";
+            Complaint* complaint = findComplaint(complaintId);
+            if (complaint == nullptr) return "ERR Complaint ID " + args + " not found.";
+            writeComplaintDetails(out, *complaint);
+            return "OK";
+        }
+    } else if (session.menu == SessionMenu::EMPLOYEE) {
+        if (command == "URGENT") {
+            showUrgentComplaints(out);
+            return "OK";
+        }
+        if (command == "UNREPLIED") {
+            writeUnrepliedComplaints(out);
+            return "OK";
+        }
+        if (command == "REPLY") {
+            vector<string> fields = splitFields(args, 2);
+            if (fields.size() != 2 || !parseIntField(fields[0], complaintId)) {
+                return "ERR Usage: REPLY id|text";
+            }
+            if (replyToComplaint(complaintId, fields[1]) == nullptr) {
+                return "ERR Complaint ID " + fields[0] + " not found.";
+            }
+            return "OK Reply added";
+        }
+        if (command == "SUMMARY") {
+            vector<string> fields = splitFields(args, 3);
+            if (fields.size() != 3 || !parseIntField(fields[0], complaintId)) {
+                return "ERR Usage: SUMMARY id|employeeId|text";
+            }
+            if (summarizeComplaint(complaintId, fields[1], fields[2]) == nullptr) {
+                return "ERR Complaint ID " + fields[0] + " not found.";
+            }
+            return "OK Summary added";
+        }
+        if (command == "SUMMARIES") {
+            writeSummaries(out, "");
+            return "OK";
+        }
+        if (command == "SEARCH") {
+            writeSummaries(out, args);
+            return "OK";
+        }
+    } else if (session.menu == SessionMenu::ADMIN) {
+        if (command == "EMPLOYEES") {
+            writeEmployees(out);
+            return "OK";
+        }
+        if (command == "ADDEMP") {
+            vector<string> fields = splitFields(args, 3);
+            if (fields.size() != 3 || fields[1].empty()) return "ERR Usage: ADDEMP name|id|password";
+            empList.emplaceFront(fields[0], fields[1], fields[2]);
+            return "OK Employee added";
+        }
+        if (command == "DELEMP") {
+            if (!removeEmployee(args)) return "ERR Employee ID " + args + " not found.";
+            return "OK Employee ID " + args + " deleted";
+        }
+        if (command == "COUNT") {
+            return "OK " + to_string(totalComplaintCount());
+        }
+        if (command == "UNREPLIED") {
+            writeUnrepliedComplaints(out);
+            return "OK";
+        }
+        if (command == "MARKURGENT") {
+            vector<string> fields = splitFields(args, 2);
+            int order;
+            if (fields.size() != 2 || !parseIntField(fields[0], complaintId) || !parseIntField(fields[1], order)) {
+                return "ERR Usage: MARKURGENT id|order";
+            }
+            if (order < MIN_URGENT_ORDER) return "ERR " + URGENT_ORDER_ERROR;
+            if (markComplaintUrgent(complaintId, order) == nullptr) {
+                return "ERR Complaint ID " + fields[0] + " not found.";
+            }
+            return "OK Complaint ID " + fields[0] + " added to urgent queue";
+        }
+        if (command == "URGENT") {
+            showUrgentComplaints(out);
+            return "OK";
+        }
+        if (command == "STATS") {
+            showStorageStats(out);
+            return "OK";
+        }
+        if (command == "ADMISSION") {
+            showAdmissionStats(out);
+            return "OK";
+        }
+        if (command == "RANGE") {
+            vector<string> fields = splitFields(args, 2);
+            int from, to;
+            if (fields.size() != 2 || !parseIntField(fields[0], from) || !parseIntField(fields[1], to)) {
+                return "ERR Usage: RANGE from|to";
+            }
+            vector<Complaint> complaints = collectComplaintRange(from, to, SERVER_LIST_LIMIT);
+            for (const Complaint& complaint : complaints) {
+                printComplaintRow(complaint, out);
+            }
+            return "OK " + to_string(complaints.size()) + " complaint(s)";
+        }
+        if (command == "SLA") {
+            showSlaReport(out);
+            return "OK";
+        }
+        if (command == "FILTER") {
+            return writeFilterResult(out, args);
+        }
+        if (command == "SAVE") {
+            saveComplaintDataToFile();
+            return "OK Saved";
+        }
+        if (command == "REPLICATION") {
+            writeReplicationStatus(out);
+            return "OK";
+        }
+        if (command == "PROMOTE") {
+            if (!promoteReplica()) return "ERR Not a read-only replica";
+            return "OK Promoted to primary";
+        }
+    }
+    return string("ERR Unknown command in ") + sessionMenuName(session.menu) + " menu; send HELP";
 }
 
-void deleteComplaint() {
-    int complaintId;
-    bool found = false;
-    cout << "Enter complaint ID to delete: ";
-    cin >> complaintId;
-    if (cin.fail()) {
-        handleInvalidInput();
-        return;
-    }
-
-    LinkedQueue::Node* current = complaintQueue.getFrontNode();
-    LinkedQueue::Node* prev = nullptr;
-    while (current != nullptr) {
-        if (current->data.id == complaintId) {
-            found = true;
-            break;
+void handleServerRequest(ClientSession& session, const string& line) {
+    size_t space = line.find(' ');
+    string command = line.substr(0, space);
+    string args = space == string::npos ? "" : line.substr(space + 1);
+    transform(command.begin(), command.end(), command.begin(), ::toupper);
+    if (session.menu == SessionMenu::REPLICA) { // Feeds only carry acknowledgements back
+        if (command == "ACK") {
+            session.ackedSequence = atol(args.c_str());
+            session.ackedAt = chrono::steady_clock::now();
         }
-        prev = current;
-        current = current->next;
+        return;
     }
-
-    if (found) {
-        if (prev == nullptr) {
-            complaintQueue.dequeue();
+    if (command == "REPLICATE") {
+        if (serverReadOnly) {
+            appendResponse(session.output, "ERR A read-only replica cannot feed other replicas", "");
         } else {
-            prev->next = current->next;
-            if (current == complaintQueue.getRearNode()) {
-                complaintQueue.setRear(prev);
-            }
-            delete current;
-            complaintQueue.decrementSize();
+            startReplicaFeed(session);
         }
-        cout << "Complaint ID " << complaintId << " deleted successfully!\n";
-    } else {
-        cout << "Complaint ID " << complaintId << " not found!\n";
+        return;
     }
-}
-
-void showComplaintDetails() {
-    int complaintId;
-    cout << "Enter complaint ID: ";
-    cin >> complaintId;
-    if (cin.fail()) {
-        handleInvalidInput();
+    if (!replicaSyncing() && ((session.menu == SessionMenu::CUSTOMER && command == "HISTORY")
+                              || (session.menu == SessionMenu::ADMIN && command == "FILTER" && !filterIndex.isBuilt()))) {
+        startSessionScan(session, command == "HISTORY" ? SessionScan::HISTORY : SessionScan::FILTER, args);
         return;
     }
+    ostringstream body;
+    string status = runServerCommand(session, command, args, body);
+    appendResponse(session.output, status, body.str());
+}
 
-    LinkedQueue::Node* current = complaintQueue.getFrontNode();
-    bool found = false;
-    while (current != nullptr) {
-        if (current->data.id == complaintId) {
-            found = true;
-            cout << "=========================================\n";
-            cout << "Complaint Details\n";
-            cout << "ID: " << current->data.id << "\n";
-            cout << "Customer Name: " << current->data.customer.getName() << "\n";
-            cout << "Customer Email: " << current->data.customer.getEmail() << "\n";
-            cout << "Content: " << current->data.content << "\n";
-            cout << "Replied: " << (current->data.replied ? "Yes" : "No") << "\n";
-            if (current->data.replied) {
-                cout << "Reply Details: " << current->data.replyDetails << "\n";
-            }
-            cout << "Urgent: " << (current->data.urgent ? "Yes" : "No") << "\n";
-            cout << "=========================================\n";
-            break;
-        }
-        current = current->next;
+// Runs every complete request line in the input buffer, pausing while the
+// client is not reading its responses
+void processSessionInput(ClientSession& session, long& requests) {
+    size_t start = 0;
+    while (!session.closing && !session.holdsRequests() && session.pendingOutput() < SERVER_MAX_PENDING_OUTPUT) {
+        size_t newline = session.input.find('\n', start);
+        if (newline == string::npos) break;
+        size_t end = newline > start && session.input[newline - 1] == '\r' ? newline - 1 : newline;
+        string line = session.input.substr(start, end - start);
+        start = newline + 1;
+        if (line.empty()) continue;
+        handleServerRequest(session, line);
+        requests++;
     }
-    if (!found) {
-        cout << "Complaint ID " << complaintId << " not found.\n";
+    session.input.erase(0, start);
+    if (session.input.size() > SERVER_MAX_LINE && session.input.find('\n') == string::npos) {
+        appendResponse(session.output, "ERR Request line too long", "");
+        session.closing = true;
     }
 }
 
-void searchHistory() {
-    string email;
-    cout << "Enter email to search complaints: ";
-    cin >> email;
-    if (complaintQueue.isEmpty()) {
-        cout << "No complaints in queue.\n";
-        return;
+// Runs the next page of a session's paged request and queues the response
+// once it is complete; true when the request has finished
+bool advanceSessionScan(ClientSession& session) {
+    if (session.scan == SessionScan::FILTER) {
+        // The build is shared, so every waiting FILTER moves it forward
+        if (!filterIndex.isBuilt()) {
+            vector<Complaint> page = collectComplaintRange(filterIndex.getIndexedThrough() + 1,
+                                                           numeric_limits<int>::max(), SERVER_SCAN_PAGE);
+            filterIndex.buildPage(page, page.size() < SERVER_SCAN_PAGE
+                                            || page.back().id == numeric_limits<int>::max());
+            if (!filterIndex.isBuilt()) return false;
+        }
+        ostringstream body;
+        string status = writeFilterResult(body, session.scanArgs);
+        appendResponse(session.output, status, body.str());
+        return true;
     }
 
-    LinkedQueue::Node* current = complaintQueue.getFrontNode();
-    bool found = false;
-    while (current != nullptr) {
-        if (current->data.customer.getEmail() == email) {
-            found = true;
-            cout << "=========================================\n";
-            cout << "Complaint ID: " << current->data.id << "\n";
-            cout << "Customer Name: " << current->data.customer.getName() << "\n";
-            cout << "Content: " << current->data.content << "\n";
-            cout << "Replied: " << (current->data.replied ? "Yes" : "No") << "\n";
-            if (current->data.replied) {
-                cout << "Reply Details: " << current->data.replyDetails << "\n";
+    // Changes made before this page are either in it or already forwarded
+    if (session.scan == SessionScan::SNAPSHOT) shipChanges();
+    vector<Complaint> page = collectComplaintRange(session.scanCursor + 1, numeric_limits<int>::max(),
+                                                   SERVER_SCAN_PAGE);
+    bool last = page.size() < SERVER_SCAN_PAGE || page.back().id == numeric_limits<int>::max();
+    if (!page.empty()) session.scanCursor = page.back().id;
+    if (session.scan == SessionScan::SNAPSHOT) {
+        for (const Complaint& complaint : page) {
+            session.output += "PUT " + encodeComplaint(complaint) + "\n";
+        }
+        session.scanCount += (int)page.size();
+        if (last) {
+            // The stack as it is now replaces whatever the replica built from
+            // SUMMARY changes forwarded during the snapshot
+            vector<const Complaint*> summaries;
+            for (const Complaint& complaint : summaryStack) summaries.push_back(&complaint);
+            session.output += "SUMMARIES\n";
+            for (auto it = summaries.rbegin(); it != summaries.rend(); ++it) {
+                session.output += "PUSH " + encodeComplaint(**it) + "\n";
             }
-            cout << "=========================================\n";
+            session.output += "LIVE " + to_string(changeLog.getSequence()) + "\n";
+            cout << "Replica snapshot sent (" << session.scanCount << " complaints); live at sequence "
+                 << changeLog.getSequence() << "\n";
         }
-        current = current->next;
+        return last;
     }
-    if (!found) {
-        cout << "No complaints found for email: " << email << "\n";
+
+    ostringstream body;
+    for (const Complaint& complaint : page) {
+        if (writeHistoryEntry(body, complaint, session.scanArgs)) session.scanCount++;
     }
+    session.scanBody += body.str();
+    if (last) appendResponse(session.output, "OK " + to_string(session.scanCount) + " complaint(s)", session.scanBody);
+    return last;
 }
 
-// Employee functions
-void addReply() {
-    int complaintId;
-    cout << "Enter complaint ID to reply: ";
-    cin >> complaintId;
-    if (cin.fail()) {
-        handleInvalidInput();
-        return;
+// Sends as much queued output as the socket takes; false on a write error
+bool flushSessionOutput(ClientSession& session) {
+    while (session.pendingOutput() > 0) {
+        ssize_t sent = send(session.fd, session.output.data() + session.outputSent,
+                            session.pendingOutput(), MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        session.outputSent += sent;
     }
+    session.output.clear();
+    session.outputSent = 0;
+    return true;
+}
 
-    LinkedQueue::Node* current = complaintQueue.getFrontNode();
-    bool found = false;
-    while (current != nullptr) {
-        if (current->data.id == complaintId) {
-            found = true;
-            string reply;
-            cout << "Enter reply details: ";
-            getline(cin >> ws, reply);
-            current->data.addReply(reply);
-            cout << "Reply added successfully!\n";
-            break;
-        }
-        current = current->next;
+// Reads one chunk; false once the peer has closed or the read failed
+bool readSessionInput(ClientSession& session) {
+    char buffer[SERVER_READ_CHUNK];
+    ssize_t received = recv(session.fd, buffer, sizeof(buffer), 0);
+    if (received > 0) {
+        session.input.append(buffer, received);
+        return true;
     }
-    if (!found) {
-        cout << "Complaint ID " << complaintId << " not found.\n";
+    return received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR);
+}
+
+void updateSessionEvents(int epollFd, ClientSession& session) {
+    uint32_t wanted = 0;
+    if (!session.closing && !session.holdsRequests() && session.pendingOutput() < SERVER_MAX_PENDING_OUTPUT) {
+        wanted |= EPOLLIN;
     }
+    if (session.pendingOutput() > 0) wanted |= EPOLLOUT;
+    if (wanted == session.events) return;
+    epoll_event event = {};
+    event.events = wanted;
+    event.data.fd = session.fd;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, session.fd, &event);
+    session.events = wanted;
 }
 
-void showUnrepliedComplaints(bool employeeMode = false) {
-    if (complaintQueue.isEmpty()) {
-        cout << "No complaints found.\n";
-        return;
+void closeServerSession(int epollFd, int fd) {
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    auto feed = find(replicaFeeds.begin(), replicaFeeds.end(), fd);
+    if (feed != replicaFeeds.end()) {
+        replicaFeeds.erase(feed);
+        cout << "Replica disconnected\n";
     }
+    scanningSessions.erase(remove(scanningSessions.begin(), scanningSessions.end(), fd), scanningSessions.end());
+    serverSessions.erase(fd);
+}
 
-    LinkedQueue::Node* current = complaintQueue.getFrontNode();
-    int count = 0;
-    cout << "=========================================\n";
-    cout << "Unreplied Complaints\n";
-    while (current != nullptr) {
-        if (!current->data.replied) {
-            count++;
-            cout << "ID: " << current->data.id << "\n";
-            cout << "Customer Name: " << current->data.customer.getName() << "\n";
-            cout << "Content: " << current->data.content << "\n";
-            cout << "Urgent: " << (current->data.urgent ? "Yes" : "No") << "\n";
-            cout << "-----------------------------------------\n";
+// Serves the menus on endpoint. With a primary endpoint the server starts as
+// a read-only replica of that primary instead of loading the data files.
+void runServer(const string& endpoint, const string& primaryEndpoint = "") {
+    raiseFileLimit();
+    int listenFd = openListenSocket(endpoint);
+    if (listenFd < 0) return;
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (primaryEndpoint.empty()) {
+        loadComplaintDataFromFile();
+    } else {
+        primaryLink.endpoint = primaryEndpoint;
+        primaryLink.fd = connectEndpoint(primaryEndpoint);
+        if (primaryLink.fd < 0) {
+            cout << "Cannot connect to primary " << primaryEndpoint << "\n";
+            close(listenFd);
+            close(epollFd);
+            return;
         }
-        current = current->next;
+        send(primaryLink.fd, "REPLICATE\n", 10, MSG_NOSIGNAL);
+        epoll_event linkEvent = {};
+        linkEvent.events = EPOLLIN;
+        linkEvent.data.fd = primaryLink.fd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, primaryLink.fd, &linkEvent);
+        primaryLink.heartbeatAt = chrono::steady_clock::now();
+        serverReadOnly = true;
     }
-    cout << "Total unreplied: " << count << "\n";
-    cout << "=========================================\n";
+    changeLog.enable();
 
-    if (employeeMode) {
-        int option;
-        do {
-            cout << "1) Reply to Complaint\n2) Back\nOption: ";
-            cin >> option;
-            if (cin.fail()) {
-                handleInvalidInput();
-                continue;
-            }
-            if (option == 1) addReply();
-        } while (option != 2);
+    epoll_event listenEvent = {};
+    listenEvent.events = EPOLLIN;
+    listenEvent.data.fd = listenFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &listenEvent);
+    signal(SIGINT, requestServerStop);
+    signal(SIGTERM, requestServerStop);
+    signal(SIGPIPE, SIG_IGN);
+    if (serverReadOnly) {
+        cout << "Serving read-only replica of " << primaryEndpoint << " on " << endpoint << "\n";
+    } else {
+        cout << "Serving on " << endpoint << " (Ctrl+C to stop and save)\n";
     }
-}
 
-void addProblemSummary() {
-    int complaintId;
-    cout << "Enter complaint ID for summary: ";
-    cin >> complaintId;
-    if (cin.fail()) {
-        handleInvalidInput();
-        return;
-    }
+    long totalSessions = 0, requests = 0;
+    size_t peakSessions = 0;
+    epoll_event events[SERVER_MAX_EVENTS];
+    auto lastHeartbeat = chrono::steady_clock::now();
 
-    LinkedQueue::Node* current = complaintQueue.getFrontNode();
-    bool found = false;
-    while (current != nullptr) {
-        if (current->data.id == complaintId) {
-            found = true;
-            string summary;
-            cout << "Enter problem summary: ";
-            getline(cin >> ws, summary);
-            current->data.addReply(summary); // Treat summary as reply
-            summaryStack.push(current->data);
-            cout << "Summary added successfully!\n";
+    while (!serverStopRequested) {
+        // Paged requests in progress keep the loop turning
+        int ready = epoll_wait(epollFd, events, SERVER_MAX_EVENTS, scanningSessions.empty() ? SERVER_TICK_MS : 0);
+        if (ready < 0 && errno != EINTR) {
+            perror("epoll_wait");
             break;
         }
-        current = current->next;
-    }
-    if (!found) {
-        cout << "Complaint ID " << complaintId << " not found.\n";
-    }
-}
+        for (int i = 0; i < ready; i++) {
+            int fd = events[i].data.fd;
+            if (fd == listenFd) {
+                int clientFd;
+                while ((clientFd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+                    ClientSession& session = serverSessions.emplace(clientFd, ClientSession(clientFd)).first->second;
+                    session.events = EPOLLIN;
+                    epoll_event event = {};
+                    event.events = EPOLLIN;
+                    event.data.fd = clientFd;
+                    epoll_ctl(epollFd, EPOLL_CTL_ADD, clientFd, &event);
+                    totalSessions++;
+                }
+                peakSessions = max(peakSessions, serverSessions.size());
+                continue;
+            }
+            if (fd == primaryLink.fd) {
+                if (!readPrimaryLink()) {
+                    closePrimaryLink();
+                    if (primaryLink.live) {
+                        cout << "Lost connection to primary; still serving read-only data, send PROMOTE to take over\n";
+                    } else {
+                        cout << "Sync failed: lost connection to primary before the snapshot completed ("
+                             << totalComplaintCount() << " complaints received); queries are refused\n";
+                    }
+                }
+                continue;
+            }
+            auto found = serverSessions.find(fd);
+            if (found == serverSessions.end()) continue;
+            ClientSession& session = found->second;
+            if ((events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) && !readSessionInput(session)) {
+                session.closing = true;
+            }
+            // Requests held back by backpressure resume once the output drains
+            bool open;
+            do {
+                processSessionInput(session, requests);
+                open = flushSessionOutput(session);
+            } while (open && !session.closing && !session.holdsRequests() && session.pendingOutput() == 0
+                     && session.input.find('\n') != string::npos);
+            if (!open || (session.closing && session.pendingOutput() == 0)) {
+                closeServerSession(epollFd, fd);
+            } else {
+                updateSessionEvents(epollFd, session);
+            }
+        }
+        if (!serverReadOnly) runSlaTimers(); // Replicas receive escalations from the primary
 
-void showComplaintsWithSummary() {
-    if (summaryStack.isEmpty()) {
-        cout << "No summaries found.\n";
-        return;
+        shipChanges();
+        // One page per paged request, skipping sessions whose client is behind
+        for (int fd : vector<int>(scanningSessions)) {
+            ClientSession& session = serverSessions.at(fd);
+            if (session.pendingOutput() >= SERVER_MAX_PENDING_OUTPUT || !advanceSessionScan(session)) continue;
+            session.scan = SessionScan::NONE;
+            session.scanBody.clear();
+            scanningSessions.erase(find(scanningSessions.begin(), scanningSessions.end(), fd));
+            if (session.menu == SessionMenu::REPLICA) continue; // Flushed with the other feeds below
+            processSessionInput(session, requests); // Requests that waited behind this one
+            if (!flushSessionOutput(session) || (session.closing && session.pendingOutput() == 0)) {
+                closeServerSession(epollFd, fd);
+            } else {
+                updateSessionEvents(epollFd, session);
+            }
+        }
+        if (millisSince(lastHeartbeat) >= SERVER_TICK_MS) {
+            sendHeartbeats();
+            lastHeartbeat = chrono::steady_clock::now();
+        }
+        for (int fd : vector<int>(replicaFeeds)) {
+            ClientSession& feed = serverSessions.at(fd);
+            if (!flushSessionOutput(feed) || feed.pendingOutput() > REPLICA_MAX_BACKLOG) {
+                closeServerSession(epollFd, fd);
+            } else {
+                updateSessionEvents(epollFd, feed);
+            }
+        }
     }
 
-    Stack tempStack;
-    cout << "=========================================\n";
-    cout << "Complaints with Summaries\n";
-    while (!summaryStack.isEmpty()) {
-        Complaint complaint = summaryStack.topComplaint();
-        cout << "ID: " << complaint.id << "\n";
-        cout << "Content: " << complaint.content << "\n";
-        cout << "Summary: " << complaint.replyDetails << "\n";
-        cout << "-----------------------------------------\n";
-        tempStack.push(complaint);
-        summaryStack.pop();
-    }
-    while (!tempStack.isEmpty()) {
-        summaryStack.push(tempStack.topComplaint());
-        tempStack.pop();
+    for (auto& entry : serverSessions) {
+        close(entry.first);
+    }
+    closePrimaryLink();
+    close(listenFd);
+    close(epollFd);
+    if (endpoint.compare(0, 5, "unix:") == 0) unlink(endpoint.substr(5).c_str());
+    cout << "\nServer stopped: " << totalSessions << " session(s), peak " << peakSessions
+         << " concurrent, " << requests << " request(s)\n";
+    if (serverReadOnly) {
+        writeReplicationStatus(cout);
+        cout << "Replica data was not saved.\n"; // The primary owns the data files
+    } else {
+        saveComplaintDataToFile();
     }
-    cout << "=========================================\n";
 }
 
-void searchByComplaintNameWithSummary() {
-    string name;
-    cout << "Enter complaint content to search: ";
-    getline(cin >> ws, name);
-    if (summaryStack.isEmpty()) {
-        cout << "No summaries found.\n";
-        return;
-    }
+// Load generator: opens many client sessions from one epoll loop. Every
+// client switches to the Customer menu and then cycles through ADD, DETAILS
+// and DELETE of its own complaint, so the store is unchanged afterwards.
+struct LoadClient {
+    int fd;
+    string input;
+    string output;
+    int sent;         // Requests sent so far
+    int lastId;       // Complaint ID from the last ADD
+    chrono::steady_clock::time_point requestStart;
+};
 
-    Stack tempStack;
-    cout << "=========================================\n";
-    cout << "Search Results\n";
-    while (!summaryStack.isEmpty()) {
-        Complaint complaint = summaryStack.topComplaint();
-        if (complaint.content.find(name) != string::npos) {
-            cout << "ID: " << complaint.id << "\n";
-            cout << "Content: " << complaint.content << "\n";
-            cout << "Summary: " << complaint.replyDetails << "\n";
-            cout << "-----------------------------------------\n";
-        }
-        tempStack.push(complaint);
-        summaryStack.pop();
-    }
-    while (!tempStack.isEmpty()) {
-        summaryStack.push(tempStack.topComplaint());
-        tempStack.pop();
+string nextLoadRequest(const LoadClient& client, int clientIndex) {
+    if (client.sent == 0) return "ROLE CUSTOMER\n";
+    switch ((client.sent - 1) % 3) {
+    case 0:
+        // A new customer per complaint, so admission control never limits the load
+        return "ADD Load Client " + to_string(clientIndex) + "|" + to_string(clientIndex) + "-" + to_string(client.sent)
+               + "|load" + to_string(clientIndex) + "-" + to_string(client.sent)
+               + "@example.com|Load test complaint " + to_string(client.sent) + "\n";
+    case 1: return "DETAILS " + to_string(client.lastId) + "\n";
+    default: return "DELETE " + to_string(client.lastId) + "\n";
     }
-    cout << "=========================================\n";
-}
-
-// Admin functions
-void addNewEmployee() {
-    string name, id, password;
-    cout << "Enter employee name: ";
-    getline(cin >> ws, name);
-    cout << "Enter employee ID: ";
-    getline(cin, id);
-    cout << "Enter employee password: ";
-    getline(cin, password);
-    Employee emp(name, id, password);
-    empList.addEmployee(emp);
 }
 
-void deleteEmployee() {
-    string id;
-    cout << "Enter employee ID to delete: ";
-    cin >> id;
-    empList.deleteEmployee(id);
-}
+void runLoadGenerator(const string& endpoint, int clientCount, int requestsPerClient) {
+    raiseFileLimit();
+    signal(SIGPIPE, SIG_IGN);
+    vector<LoadClient> clients(clientCount);
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    for (int i = 0; i < clientCount; i++) {
+        clients[i].fd = connectEndpoint(endpoint);
+        if (clients[i].fd < 0) {
+            cout << "Connect to " << endpoint << " failed after " << i << " client(s): " << strerror(errno) << "\n";
+            for (int j = 0; j < i; j++) close(clients[j].fd);
+            close(epollFd);
+            return;
+        }
+        clients[i].sent = 0;
+        clients[i].lastId = 0;
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.u32 = i;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, clients[i].fd, &event);
+    }
+    cout << "Connected " << clientCount << " client(s) to " << endpoint << "\n";
 
-void addUrgentComplaint() {
-    int complaintId;
-    cout << "Enter complaint ID for urgent: ";
-    cin >> complaintId;
-    if (cin.fail()) {
-        handleInvalidInput();
-        return;
+    vector<long> latencies; // Microseconds per request
+    latencies.reserve((size_t)clientCount * (requestsPerClient + 1));
+    long errors = 0;
+    int active = clientCount;
+    auto start = chrono::steady_clock::now();
+    auto sendNext = [&](LoadClient& client, int index) {
+        string request = nextLoadRequest(client, index);
+        client.requestStart = chrono::steady_clock::now();
+        client.sent++;
+        // Requests are tiny, so a short write only happens on a broken socket
+        if (send(client.fd, request.data(), request.size(), MSG_NOSIGNAL) != (ssize_t)request.size()) {
+            errors++;
+        }
+    };
+    for (int i = 0; i < clientCount; i++) {
+        sendNext(clients[i], i);
     }
 
-    LinkedQueue::Node* current = complaintQueue.getFrontNode();
-    bool found = false;
-    while (current != nullptr) {
-        if (current->data.id == complaintId) {
-            found = true;
-            int order;
-            cout << "Enter priority order (lower = higher priority): ";
-            cin >> order;
-            if (cin.fail()) {
-                handleInvalidInput();
-                return;
-            }
-            current->data.urgent = true;
-            urgentQueue.insert(order, current->data);
-            cout << "Complaint ID " << complaintId << " added to urgent queue.\n";
+    epoll_event events[SERVER_MAX_EVENTS];
+    char buffer[SERVER_READ_CHUNK];
+    while (active > 0) {
+        int ready = epoll_wait(epollFd, events, SERVER_MAX_EVENTS, 10000);
+        if (ready == 0) {
+            cout << "Timed out waiting for responses.\n";
             break;
         }
-        current = current->next;
+        for (int i = 0; i < ready; i++) {
+            int index = events[i].data.u32;
+            LoadClient& client = clients[index];
+            ssize_t received = recv(client.fd, buffer, sizeof(buffer), 0);
+            if (received <= 0) {
+                if (received < 0 && errno == EAGAIN) continue;
+                errors++;
+                epoll_ctl(epollFd, EPOLL_CTL_DEL, client.fd, nullptr);
+                active--;
+                continue;
+            }
+            client.input.append(buffer, received);
+            size_t end = client.input.find("\n.\n");
+            if (end == string::npos) continue; // One request in flight, so one response
+            latencies.push_back((long)chrono::duration_cast<chrono::microseconds>(
+                chrono::steady_clock::now() - client.requestStart).count());
+            if (client.input.compare(0, 2, "OK") != 0) {
+                errors++;
+            } else if (client.sent % 3 == 2) {
+                client.lastId = atoi(client.input.c_str() + 3); // "OK <id>" from ADD
+            }
+            client.input.clear();
+            if (client.sent > requestsPerClient && (client.sent - 1) % 3 == 0) { // Finish on a DELETE
+                epoll_ctl(epollFd, EPOLL_CTL_DEL, client.fd, nullptr);
+                active--;
+            } else {
+                sendNext(client, index);
+            }
+        }
     }
-    if (!found) {
-        cout << "Complaint ID " << complaintId << " not found.\n";
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    for (LoadClient& client : clients) {
+        close(client.fd);
     }
+    close(epollFd);
+
+    sort(latencies.begin(), latencies.end());
+    auto percentile = [&](size_t p) {
+        return latencies.empty() ? 0L : latencies[(latencies.size() * p + 99) / 100 - 1];
+    };
+    cout << "Requests: " << latencies.size() << ", errors: " << errors << "\n";
+    cout << "Elapsed: " << (long)(seconds * 1000) << " ms, "
+         << (long)(latencies.size() / max(seconds, 1e-9)) << " requests/sec\n";
+    cout << "Latency p50: " << percentile(50) << " us, p99: " << percentile(99)
+         << " us, max: " << (latencies.empty() ? 0L : latencies.back()) << " us\n";
 }
+#endif
 
-// File I/O functions
-void loadComplaintDataFromFile() {
-    ifstream inFile("complaint_data.txt");
-    if (!inFile.is_open()) {
-        cout << "No complaint data file found. Starting empty.\n";
-        return;
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "--bench-reports") {
+        runReportBenchmark(argc > 2 ? atol(argv[2]) : 10000000L);
+        return 0;
     }
-
-    int id;
-    string content, name, phone, email, replyDetails;
-    bool replied, urgent;
-    while (inFile >> id) {
-        inFile.ignore();
-        getline(inFile, content);
-        inFile >> replied >> urgent;
-        inFile.ignore();
-        getline(inFile, name);
-        getline(inFile, phone);
-        getline(inFile, email);
-        getline(inFile, replyDetails);
-
-        Customer customer(name, phone, email);
-        Complaint complaint(content, replied, urgent, customer);
-        complaint.id = id;
-        complaint.replyDetails = replyDetails;
-        complaintQueue.enqueue(complaint);
+    if (argc > 1 && string(argv[1]) == "--check-index") {
+        return runIndexCheck(argc > 2 ? atol(argv[2]) : 100000L) == 0 ? 0 : 1;
     }
-    inFile.close();
-    cout << "Complaint data loaded successfully!\n";
-}
-
-void saveComplaintDataToFile() {
-    ofstream outFile("complaint_data.txt");
-    if (!outFile.is_open()) {
-        cout << "Error: Unable to open file for writing!\n";
-        return;
+    if (argc > 1 && string(argv[1]) == "--bench-containers") {
+        runContainerBenchmark(argc > 2 ? atol(argv[2]) : 100000L);
+        return 0;
     }
-
-    LinkedQueue::Node* current = complaintQueue.getFrontNode();
-    while (current != nullptr) {
-        outFile << current->data.id << "\n";
-        outFile << current->data.content << "\n";
-        outFile << current->data.replied << "\n";
-        outFile << current->data.urgent << "\n";
-        outFile << current->data.customer.getName() << "\n";
-        outFile << current->data.customer.getPhone() << "\n";
-        outFile << current->data.customer.getEmail() << "\n";
-        outFile << current->data.replyDetails << "\n";
-        current = current->next;
+    if (argc > 2 && (string(argv[1]) == "--export" || string(argv[1]) == "--import")) {
+        TransferFormat format;
+        if (!transferFormatOf(argv[2], format)) {
+            cout << "Unsupported file type; use .jsonl or .csv\n";
+            return 1;
+        }
+        loadComplaintDataFromFile();
+        if (string(argv[1]) == "--export") {
+            exportComplaints(argv[2], format);
+        } else {
+            importComplaints(argv[2], format);
+            saveComplaintDataToFile();
+        }
+        return 0;
     }
-    outFile.close();
-    cout << "Complaint data saved successfully!\n";
-}
+    if (argc > 1 && string(argv[1]) == "--bench-admission") {
+        runAdmissionBenchmark(argc > 2 ? atol(argv[2]) : 10000000L);
+        return 0;
+    }
+#ifdef __linux__
+    if (argc > 2 && string(argv[1]) == "--serve") {
+        runServer(argv[2]);
+        return 0;
+    }
+    if (argc > 3 && string(argv[1]) == "--replica") {
+        runServer(argv[3], argv[2]);
+        return 0;
+    }
+    if (argc > 2 && string(argv[1]) == "--loadgen") {
+        runLoadGenerator(argv[2], argc > 3 ? max(1, atoi(argv[3])) : 100, argc > 4 ? max(1, atoi(argv[4])) : 1000);
+        return 0;
+    }
+#endif
 
-int main() {
+    slaNotices = &cout;
     loadComplaintDataFromFile();
     int choice;
     do {
+        runSlaTimers();
         cout << "\n============================================\n";
         cout << "        Complaint Management System\n";
         cout << "============================================\n\n";
@@ -795,6 +5390,7 @@ int main() {
         case 1: {
             int option;
             do {
+                runSlaTimers();
                 cout << "\n======================\n";
                 cout << "    Customer Menu\n";
                 cout << "1) Add Complaint\n2) Delete Complaint\n3) View Details\n";
@@ -818,6 +5414,7 @@ int main() {
         case 2: {
             int option;
             do {
+                runSlaTimers();
                 cout << "\n======================\n";
                 cout << "    Employee Menu\n";
                 cout << "1) View Urgent\n2) View Unreplied\n3) Reply\n";
@@ -829,7 +5426,7 @@ int main() {
                     continue;
                 }
                 switch (option) {
-                case 1: urgentQueue.display(); break;
+                case 1: showUrgentComplaints(); break;
                 case 2: showUnrepliedComplaints(true); break;
                 case 3: addReply(); break;
                 case 4: addProblemSummary(); break;
@@ -844,9 +5441,11 @@ int main() {
         case 3: {
             int option;
             do {
+                runSlaTimers();
                 cout << "\n======================\n";
                 cout << "     Admin Menu\n";
-                cout << "1) Employee List\n2) Complaint List\n0) Back\nOption: ";
+                cout << "1) Employee List\n2) Complaint List\n3) Compression\n4) Reports\n5) Import/Export\n";
+                cout << "0) Back\nOption: ";
                 cin >> option;
                 if (cin.fail()) {
                     handleInvalidInput();
@@ -856,6 +5455,7 @@ int main() {
                 case 1: {
                     int subOption;
                     do {
+                        runSlaTimers();
                         cout << "\n==============================\n";
                         cout << "    Employee List Menu\n";
                         cout << "1) Add Employee\n2) View Employees\n";
@@ -867,7 +5467,7 @@ int main() {
                         }
                         switch (subOption) {
                         case 1: addNewEmployee(); break;
-                        case 2: empList.displayEmployees(); break;
+                        case 2: displayEmployees(); break;
                         case 3: deleteEmployee(); break;
                         case 0: break;
                         default: cout << "Invalid option.\n";
@@ -878,20 +5478,80 @@ int main() {
                 case 2: {
                     int subOption;
                     do {
+                        runSlaTimers();
                         cout << "\n==============================\n";
                         cout << "    Complaint List Menu\n";
                         cout << "1) View Count\n2) View Unreplied\n";
-                        cout << "3) Add Urgent\n4) View Urgent\n0) Back\nOption: ";
+                        cout << "3) Add Urgent\n4) View Urgent\n5) Storage Stats\n";
+                        cout << "6) View ID Range\n7) Browse by ID\n8) SLA Report\n";
+                        cout << "9) SLA Settings\n10) Filter Complaints\n11) Admission Control\n0) Back\nOption: ";
                         cin >> subOption;
                         if (cin.fail()) {
                             handleInvalidInput();
                             continue;
                         }
                         switch (subOption) {
-                        case 1: cout << "Total complaints: " << complaintQueue.getSize() << "\n"; break;
+                        case 1:
+                            cout << "Total complaints: " << totalComplaintCount() << "\n";
+                            break;
                         case 2: showUnrepliedComplaints(); break;
                         case 3: addUrgentComplaint(); break;
-                        case 4: urgentQueue.display(); break;
+                        case 4: showUrgentComplaints(); break;
+                        case 5: showStorageStats(); break;
+                        case 6: showComplaintRange(); break;
+                        case 7: browseComplaints(); break;
+                        case 8: showSlaReport(); break;
+                        case 9: editSlaSettings(); break;
+                        case 10: filterComplaints(); break;
+                        case 11: showAdmissionStats(); break;
+                        case 0: break;
+                        default: cout << "Invalid option.\n";
+                        }
+                    } while (subOption != 0);
+                    break;
+                }
+                case 3: {
+                    int subOption;
+                    do {
+                        runSlaTimers();
+                        cout << "\n==============================\n";
+                        cout << "    Compression Menu\n";
+                        cout << "1) Train Dictionary\n2) Compression Stats\n0) Back\nOption: ";
+                        cin >> subOption;
+                        if (cin.fail()) {
+                            handleInvalidInput();
+                            continue;
+                        }
+                        switch (subOption) {
+                        case 1: trainCompressionDictionary(); break;
+                        case 2: showCompressionStats(); break;
+                        case 0: break;
+                        default: cout << "Invalid option.\n";
+                        }
+                    } while (subOption != 0);
+                    break;
+                }
+                case 4: showReports(); break;
+                case 5: {
+                    int subOption;
+                    do {
+                        runSlaTimers();
+                        cout << "\n==============================\n";
+                        cout << "    Import/Export Menu\n";
+                        cout << "1) Export Complaints\n2) Import Complaints\n0) Back\nOption: ";
+                        cin >> subOption;
+                        if (cin.fail()) {
+                            handleInvalidInput();
+                            continue;
+                        }
+                        switch (subOption) {
+                        case 1: transferComplaints(false); break;
+                        case 2:
+                            transferComplaints(true);
+                            // Imported cold segments are already on disk; save so the
+                            // manifest and the last ID match them
+                            saveComplaintDataToFile();
+                            break;
                         case 0: break;
                         default: cout << "Invalid option.\n";
                         }